@@ -0,0 +1,168 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Aggregator.hpp"
+#include "ValueUtils.hpp"
+
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Result
+
+Aggregator::Result::Result()
+  : count(0)
+  , numbersCount(0)
+  , isInteger(true)
+  , integerSum(0)
+  , sum(0)
+  , min(0)
+  , max(0)
+{}
+
+void Aggregator::Result::add(const Executor::AbstractObjectWrapper& value) {
+
+  count ++;
+
+  v_int64 integer = 0;
+  v_float64 number = 0;
+  bool valueIsInteger = false;
+
+  if(!ValueUtils::readNumber(value, integer, number, valueIsInteger)) {
+    return;
+  }
+
+  if(numbersCount == 0) {
+    min = number;
+    max = number;
+  } else if(number < min) {
+    min = number;
+  } else if(number > max) {
+    max = number;
+  }
+
+  numbersCount ++;
+  sum += number;
+  if(valueIsInteger) {
+    integerSum += integer;
+  } else {
+    isInteger = false;
+  }
+
+}
+
+v_float64 Aggregator::Result::getAverage() const {
+  if(numbersCount == 0) {
+    return 0;
+  }
+  return sum / numbersCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Aggregator
+
+Aggregator::Aggregator()
+  : m_groupLevel(-1)
+  , m_hasGroup(false)
+{}
+
+Aggregator::Aggregator(v_int32 groupLevel, const GroupCallback& callback)
+  : m_groupLevel(groupLevel)
+  , m_groupCallback(callback)
+  , m_hasGroup(false)
+{
+  if(groupLevel < 0) {
+    throw std::runtime_error("[oatpp::dtoql::Aggregator::Aggregator()]: Error. Group level can't be negative.");
+  }
+  m_group.reserve(groupLevel + 1);
+}
+
+void Aggregator::flushGroup() {
+  if(m_hasGroup) {
+    if(m_groupCallback) {
+      m_groupCallback(m_group.data(), (v_int32) m_group.size(), m_groupResult);
+    }
+    m_groupResult = Result();
+    m_hasGroup = false;
+  }
+}
+
+Aggregator::Action Aggregator::onRow(const Executor::Row& row) {
+
+  const auto& value = *row[row.getSize() - 1].value;
+  m_result.add(value);
+
+  if(m_groupLevel < 0) {
+    return CONTINUE;
+  }
+
+  if(m_groupLevel >= row.getSize()) {
+    throw std::runtime_error("[oatpp::dtoql::Aggregator::onRow()]: Error. Group level is out of row.");
+  }
+
+  if(m_hasGroup && row.getChangedLevel() <= m_groupLevel) {
+    flushGroup();
+  }
+
+  if(!m_hasGroup) {
+    m_group.clear();
+    for(v_int32 i = 0; i <= m_groupLevel; i ++) {
+      m_group.push_back(row[i]);
+    }
+    m_hasGroup = true;
+  }
+
+  m_groupResult.add(value);
+
+  return CONTINUE;
+
+}
+
+void Aggregator::finish() {
+  flushGroup();
+}
+
+const Aggregator::Result& Aggregator::getResult() const {
+  return m_result;
+}
+
+Aggregator::Result Aggregator::aggregate(const std::shared_ptr<CompiledPath>& plan, const Executor::AbstractObjectWrapper& root) {
+  Aggregator aggregator;
+  Executor::execute(plan, root, aggregator);
+  return aggregator.getResult();
+}
+
+Aggregator::Result Aggregator::aggregate(const std::shared_ptr<CompiledPath>& plan, const Executor::AbstractObjectWrapper& root,
+                                         v_int32 groupLevel, const GroupCallback& callback)
+{
+  Aggregator aggregator(groupLevel, callback);
+  Executor executor(plan, root);
+  executor.run(aggregator);
+  aggregator.finish();
+  return aggregator.getResult();
+}
+
+}}
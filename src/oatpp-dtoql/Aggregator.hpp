@@ -0,0 +1,147 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Aggregator_hpp
+#define oatpp_dtoql_Aggregator_hpp
+
+#include "./Executor.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Aggregates rows while the query runs - count of rows, and sum, min, max, average of numeric leaves. <br>
+ * State is constant size - nothing is materialized. <br>
+ * With group level set, rows are also aggregated per field at that level of the row
+ * (level `0` is the root), and each group is reported as soon as the executor leaves it.
+ * Rows must come in executor order. Groups without rows are not reported. <br>
+ * Call &l:Aggregator::finish (); after the last row.
+ */
+class Aggregator : public Executor::RowVisitor {
+public:
+
+  /**
+   * Aggregate values.
+   */
+  struct Result {
+
+    /**
+     * Number of rows.
+     */
+    v_int64 count;
+
+    /**
+     * Number of rows with non-null numeric leaf. Other leaves are counted but not summed.
+     */
+    v_int64 numbersCount;
+
+    /**
+     * `true` if all numbers are integers. Then &id:oatpp::dtoql::Aggregator::Result::integerSum; is exact.
+     */
+    bool isInteger;
+
+    v_int64 integerSum;
+    v_float64 sum;
+    v_float64 min;
+    v_float64 max;
+
+    Result();
+
+    void add(const Executor::AbstractObjectWrapper& value);
+
+    /**
+     * Get average of numbers.
+     * @return - average or `0` if there were no numbers.
+     */
+    v_float64 getAverage() const;
+
+  };
+
+  /**
+   * Called for each group.
+   * `group` - fields of the row from the root to the group level. Valid only for the duration of the call.
+   */
+  typedef std::function<void (const Executor::FieldView* group, v_int32 size, const Result& result)> GroupCallback;
+
+private:
+  void flushGroup();
+private:
+  v_int32 m_groupLevel;
+  GroupCallback m_groupCallback;
+  Result m_result;
+  Result m_groupResult;
+  std::vector<Executor::FieldView> m_group;
+  bool m_hasGroup;
+public:
+
+  /**
+   * Constructor. Group-free aggregation.
+   */
+  Aggregator();
+
+  /**
+   * Constructor. Aggregation per field at group level.
+   * @param groupLevel - level of the row to group by. `0` - root.
+   * @param callback - &l:Aggregator::GroupCallback;.
+   */
+  Aggregator(v_int32 groupLevel, const GroupCallback& callback);
+
+  Action onRow(const Executor::Row& row) override;
+
+  /**
+   * Report the last group. Call before the executor which produced the rows is destroyed -
+   * the group fields point into it (the root field) and into the root object.
+   */
+  void finish();
+
+  /**
+   * Get aggregate of all rows.
+   * @return - &l:Aggregator::Result;.
+   */
+  const Result& getResult() const;
+
+  /**
+   * Execute query aggregating all rows.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @return - &l:Aggregator::Result;.
+   */
+  static Result aggregate(const std::shared_ptr<CompiledPath>& plan, const Executor::AbstractObjectWrapper& root);
+
+  /**
+   * Execute query aggregating rows per field at group level.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param groupLevel - level of the row to group by. `0` - root.
+   * @param callback - &l:Aggregator::GroupCallback;.
+   * @return - &l:Aggregator::Result; of all rows.
+   */
+  static Result aggregate(const std::shared_ptr<CompiledPath>& plan, const Executor::AbstractObjectWrapper& root,
+                          v_int32 groupLevel, const GroupCallback& callback);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Aggregator_hpp
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Arena.hpp"
+
+namespace oatpp { namespace dtoql {
+
+Arena::Arena(v_int64 chunkSize)
+  : m_chunk(0)
+  , m_offset(0)
+  , m_chunkSize(chunkSize)
+{}
+
+Arena::~Arena() {
+  for(auto& chunk : m_chunks) {
+    delete [] chunk.data;
+  }
+}
+
+void* Arena::allocateInNextChunk(v_int64 size, v_int64 align) {
+
+  v_int64 required = size + align;
+
+  /* skip reusable chunks which are too small for this request */
+  v_int32 next = m_chunks.empty() ? 0 : m_chunk + 1;
+  while(next < m_chunks.size() && m_chunks[next].size < required) {
+    next ++;
+  }
+
+  if(next == m_chunks.size()) {
+    Chunk chunk;
+    chunk.size = required > m_chunkSize ? required : m_chunkSize;
+    chunk.data = new v_char8[chunk.size];
+    m_chunks.push_back(chunk);
+  }
+
+  m_chunk = next;
+  m_offset = 0;
+
+  return allocate(size, align);
+
+}
+
+void* Arena::allocate(v_int64 size, v_int64 align) {
+
+  if(!m_chunks.empty()) {
+    const Chunk& chunk = m_chunks[m_chunk];
+    v_int64 address = (v_int64) (chunk.data + m_offset);
+    v_int64 padding = (align - (address & (align - 1))) & (align - 1);
+    if(m_offset + padding + size <= chunk.size) {
+      void* result = chunk.data + m_offset + padding;
+      m_offset += padding + size;
+      return result;
+    }
+  }
+
+  return allocateInNextChunk(size, align);
+
+}
+
+Arena::Mark Arena::getMark() const {
+  return Mark{m_chunk, m_offset};
+}
+
+void Arena::rewind(const Mark& mark) {
+  m_chunk = mark.chunk;
+  m_offset = mark.offset;
+}
+
+void Arena::reset() {
+  m_chunk = 0;
+  m_offset = 0;
+}
+
+v_int32 Arena::getChunksCount() const {
+  return (v_int32) m_chunks.size();
+}
+
+v_int64 Arena::getCapacity() const {
+  v_int64 result = 0;
+  for(const auto& chunk : m_chunks) {
+    result += chunk.size;
+  }
+  return result;
+}
+
+}}
@@ -0,0 +1,123 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Arena_hpp
+#define oatpp_dtoql_Arena_hpp
+
+#include "oatpp/core/base/Environment.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Monotonic chunked allocator with stack-like rewind. <br>
+ * Memory is never returned to the system until the arena is destroyed, so an arena reused across
+ * queries stops allocating once it has grown to the working set of the largest query. <br>
+ * Only trivially destructible objects may be placed in the arena - destructors are never called.
+ */
+class Arena {
+public:
+
+  struct Mark {
+    v_int32 chunk;
+    v_int64 offset;
+  };
+
+private:
+
+  struct Chunk {
+    v_char8* data;
+    v_int64 size;
+  };
+
+private:
+  std::vector<Chunk> m_chunks;
+  v_int32 m_chunk;
+  v_int64 m_offset;
+  v_int64 m_chunkSize;
+private:
+  void* allocateInNextChunk(v_int64 size, v_int64 align);
+public:
+
+  /**
+   * Constructor.
+   * @param chunkSize - default size of a chunk. Larger chunks are allocated for larger requests.
+   */
+  Arena(v_int64 chunkSize = 64 * 1024);
+
+  Arena(const Arena& other) = delete;
+  Arena& operator=(const Arena& other) = delete;
+
+  ~Arena();
+
+  /**
+   * Allocate memory.
+   * @param size - size in bytes.
+   * @param align - alignment. Must be a power of two.
+   * @return - pointer to memory valid until the arena is rewound past it or reset.
+   */
+  void* allocate(v_int64 size, v_int64 align = alignof(std::max_align_t));
+
+  template<class T>
+  T* allocate(v_int64 count) {
+    return static_cast<T*>(allocate(count * (v_int64) sizeof(T), (v_int64) alignof(T)));
+  }
+
+  /**
+   * Get current allocation position.
+   * @return - &l:Arena::Mark;.
+   */
+  Mark getMark() const;
+
+  /**
+   * Release everything allocated after the mark was taken.
+   * @param mark - &l:Arena::Mark;.
+   */
+  void rewind(const Mark& mark);
+
+  /**
+   * Release everything. Chunks are kept for reuse.
+   */
+  void reset();
+
+  /**
+   * Number of chunks allocated from the system over arena lifetime.
+   * @return
+   */
+  v_int32 getChunksCount() const;
+
+  /**
+   * Total bytes held by the arena.
+   * @return
+   */
+  v_int64 getCapacity() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Arena_hpp
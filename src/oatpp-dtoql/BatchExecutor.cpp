@@ -0,0 +1,90 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BatchExecutor.hpp"
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BatchExecutor
+
+BatchExecutor::BatchExecutor(const std::shared_ptr<CompiledPath>& plan, MapIndexCache* mapIndexCache)
+  : m_plan(plan)
+  , m_mapIndexCache(mapIndexCache)
+{}
+
+bool BatchExecutor::executeRoot(v_int32 rootIndex, const Executor::AbstractObjectWrapper& root, RowVisitor& visitor, v_int64& rowsCount) {
+
+  m_executor.start(m_plan, root, m_mapIndexCache);
+
+  while(m_executor.next()) {
+    rowsCount ++;
+    if(visitor.onRow(rootIndex, m_executor.getRow()) == Executor::RowVisitor::STOP) {
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+v_int64 BatchExecutor::execute(const Executor::AbstractObjectWrapper* roots, v_int32 count, RowVisitor& visitor) {
+  return execute(roots, roots + count, visitor);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// BatchResult
+
+Executor::RowVisitor::Action BatchResult::onRow(v_int32 rootIndex, const Executor::Row& row) {
+  m_rows.push_back(RowRecord{rootIndex, (v_int64) m_fields.size(), row.getSize()});
+  for(v_int32 i = 0; i < row.getSize(); i ++) {
+    const auto& view = row[i];
+    m_fields.push_back(Traverser::Field(view.getName(), view.index, *view.value));
+  }
+  return Executor::RowVisitor::CONTINUE;
+}
+
+v_int64 BatchResult::getRowsCount() const {
+  return (v_int64) m_rows.size();
+}
+
+v_int32 BatchResult::getRootIndex(v_int64 row) const {
+  return m_rows[row].rootIndex;
+}
+
+v_int32 BatchResult::getRowSize(v_int64 row) const {
+  return m_rows[row].fieldsCount;
+}
+
+const Traverser::Field* BatchResult::getRow(v_int64 row) const {
+  return m_fields.data() + m_rows[row].fieldsBegin;
+}
+
+void BatchResult::clear() {
+  m_rows.clear();
+  m_fields.clear();
+}
+
+}}
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_BatchExecutor_hpp
+#define oatpp_dtoql_BatchExecutor_hpp
+
+#include "./Traverser.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Executes one query over a batch of roots. <br>
+ * One &l:Executor; is reused for all roots, so the arena, frames and inline property caches
+ * are warmed up by the first root and reused by the rest.
+ */
+class BatchExecutor {
+public:
+
+  /**
+   * Consumer of rows of &l:BatchExecutor;.
+   */
+  class RowVisitor {
+  public:
+    virtual ~RowVisitor() = default;
+
+    /**
+     * Called for each row.
+     * @param rootIndex - index of the root in the batch.
+     * @param row - &l:Executor::Row;.
+     * @return - &l:Executor::RowVisitor::Action;. `STOP` terminates the whole batch.
+     */
+    virtual Executor::RowVisitor::Action onRow(v_int32 rootIndex, const Executor::Row& row) = 0;
+  };
+
+private:
+  bool executeRoot(v_int32 rootIndex, const Executor::AbstractObjectWrapper& root, RowVisitor& visitor, v_int64& rowsCount);
+private:
+  std::shared_ptr<CompiledPath> m_plan;
+  MapIndexCache* m_mapIndexCache;
+  Executor m_executor;
+public:
+
+  /**
+   * Constructor.
+   * @param plan - &l:CompiledPath;.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   */
+  BatchExecutor(const std::shared_ptr<CompiledPath>& plan, MapIndexCache* mapIndexCache = nullptr);
+
+  /**
+   * Execute query over roots in `[begin, end)`. Roots must be convertible to &id:oatpp::data::mapping::type::AbstractObjectWrapper;.
+   * @param begin - first root.
+   * @param end - past the last root.
+   * @param visitor - &l:BatchExecutor::RowVisitor;.
+   * @return - number of rows visited.
+   */
+  template<class Iterator>
+  v_int64 execute(Iterator begin, Iterator end, RowVisitor& visitor) {
+    v_int64 rowsCount = 0;
+    v_int32 rootIndex = 0;
+    for(; begin != end; ++ begin) {
+      if(!executeRoot(rootIndex ++, *begin, visitor, rowsCount)) {
+        break;
+      }
+    }
+    return rowsCount;
+  }
+
+  v_int64 execute(const Executor::AbstractObjectWrapper* roots, v_int32 count, RowVisitor& visitor);
+
+};
+
+/**
+ * Rows of a batch in one flat buffer. Rows keep the index of their root.
+ */
+class BatchResult : public BatchExecutor::RowVisitor {
+private:
+
+  struct RowRecord {
+    v_int32 rootIndex;
+    v_int64 fieldsBegin;
+    v_int32 fieldsCount;
+  };
+
+private:
+  std::vector<RowRecord> m_rows;
+  std::vector<Traverser::Field> m_fields;
+public:
+
+  Executor::RowVisitor::Action onRow(v_int32 rootIndex, const Executor::Row& row) override;
+
+  v_int64 getRowsCount() const;
+
+  v_int32 getRootIndex(v_int64 row) const;
+
+  v_int32 getRowSize(v_int64 row) const;
+
+  /**
+   * Get fields of the row.
+   * @param row - row index.
+   * @return - pointer to &l:BatchResult::getRowSize (); fields, starting with the root.
+   */
+  const Traverser::Field* getRow(v_int64 row) const;
+
+  void clear();
+
+};
+
+}}
+
+#endif // oatpp_dtoql_BatchExecutor_hpp
@@ -0,0 +1,460 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CompiledPath.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+constexpr v_int32 CompiledPath::FLAG_SLICE_HAS_START;
+constexpr v_int32 CompiledPath::FLAG_SLICE_HAS_END;
+
+CompiledPath::CompiledPath(const std::shared_ptr<Path>& path)
+  : m_path(path)
+{
+
+  if(!m_path) {
+    return;
+  }
+
+  const auto& components = m_path->getComponents();
+
+  for(v_int32 i = 0; i < components.size(); i ++) {
+
+    const auto& component = components[i];
+
+    switch(component->getType()) {
+
+      case Path::ComponentType::FIELD_COLLECTION:
+        addSelection(i, std::static_pointer_cast<Path::FieldCollection>(component)->getFields());
+        break;
+
+      case Path::ComponentType::VARIABLE:
+      case Path::ComponentType::FILTER:
+      case Path::ComponentType::RECURSIVE_DESCENT: {
+        Instruction instruction;
+        instruction.opcode = SELECT_ALL;
+        instruction.componentIndex = i;
+        instruction.fieldsBegin = 0;
+        instruction.fieldsCount = 0;
+        instruction.sortedIndexesBegin = 0;
+        instruction.sortedIndexesCount = 0;
+        instruction.namesCount = 0;
+        instruction.nameTableBegin = 0;
+        instruction.nameTableMask = 0;
+        instruction.dynamicIndexes = 0;
+        instruction.predicate = -1;
+        instruction.maxDepth = -1;
+        if(component->getType() == Path::ComponentType::VARIABLE) {
+          auto name = std::static_pointer_cast<Path::Variable>(component)->getName();
+          if(name) {
+            if(getVariableLevel(name->std_str()) >= 0) {
+              throw std::runtime_error("[oatpp::dtoql::CompiledPath::CompiledPath()]: Error. Variable '$" + name->std_str() + "' is bound more than once.");
+            }
+            m_variables.push_back({name->std_str(), (v_int32) m_instructions.size() + 1});
+          }
+        } else if(component->getType() == Path::ComponentType::RECURSIVE_DESCENT) {
+          instruction.opcode = SELECT_DESCENDANTS;
+          instruction.maxDepth = std::static_pointer_cast<Path::RecursiveDescent>(component)->getMaxDepth();
+        } else if(component->getType() == Path::ComponentType::FILTER) {
+          instruction.predicate = (v_int32) m_predicates.size();
+          m_predicates.push_back(std::make_shared<Predicate>(std::static_pointer_cast<Path::Filter>(component)->getExpression()));
+        }
+        m_instructions.push_back(instruction);
+        break;
+      }
+
+      default:
+        break;
+
+    }
+
+  }
+
+  finalize();
+
+}
+
+void CompiledPath::addSelection(v_int32 componentIndex, const std::vector<Path::FieldReference>& fields) {
+
+  Instruction instruction;
+  instruction.opcode = SELECT_FIELDS;
+  instruction.componentIndex = componentIndex;
+  instruction.fieldsBegin = (v_int32) m_fields.size();
+  instruction.fieldsCount = (v_int32) fields.size();
+  instruction.sortedIndexesBegin = (v_int32) m_sortedIndexes.size();
+  instruction.namesCount = 0;
+  instruction.nameTableBegin = 0;
+  instruction.nameTableMask = 0;
+  instruction.dynamicIndexes = 0;
+  instruction.predicate = -1;
+  instruction.maxDepth = -1;
+
+  for(const auto& f : fields) {
+
+    FieldRef ref;
+    ref.type = f.getType();
+    ref.nameIndex = -1;
+    ref.name = nullptr;
+    ref.nameSize = 0;
+    ref.index = f.getIndex();
+    ref.end = 0;
+    ref.step = 1;
+    ref.flags = 0;
+    ref.hash = 0;
+    ref.firstOccurrence = (v_int32) m_fields.size() - instruction.fieldsBegin;
+
+    switch(f.getType()) {
+
+      case Path::FieldReference::Type::NAME: {
+        auto name = f.getName();
+        ref.nameIndex = (v_int32) m_names.size();
+        m_names.push_back(std::string((const char*) name->getData(), name->getSize()));
+        m_nameStrings.push_back(name);
+        break;
+      }
+
+      case Path::FieldReference::Type::INDEX:
+        if(ref.index < 0) {
+          /* negative indexes depend on container size */
+          instruction.dynamicIndexes = 1;
+        } else {
+          m_sortedIndexes.push_back((v_int32) m_fields.size() - instruction.fieldsBegin);
+        }
+        break;
+
+      case Path::FieldReference::Type::SLICE: {
+        const auto& slice = f.getSlice();
+        ref.index = slice.getStart();
+        ref.end = slice.getEnd();
+        ref.step = slice.getStep();
+        ref.flags = (slice.hasStart() ? FLAG_SLICE_HAS_START : 0) | (slice.hasEnd() ? FLAG_SLICE_HAS_END : 0);
+        instruction.dynamicIndexes = 1;
+        break;
+      }
+
+    }
+
+    m_fields.push_back(ref);
+
+  }
+
+  instruction.sortedIndexesCount = (v_int32) m_sortedIndexes.size() - instruction.sortedIndexesBegin;
+
+  const FieldRef* refs = &m_fields[instruction.fieldsBegin];
+  std::stable_sort(m_sortedIndexes.begin() + instruction.sortedIndexesBegin, m_sortedIndexes.end(), [refs](v_int32 a, v_int32 b) {
+    return refs[a].index < refs[b].index;
+  });
+
+  m_instructions.push_back(instruction);
+
+}
+
+void CompiledPath::finalize() {
+  /* names are pointed to only after m_names stopped growing - std::string may relocate its buffer on move */
+  for(auto& ref : m_fields) {
+    if(ref.nameIndex >= 0) {
+      const auto& name = m_names[ref.nameIndex];
+      ref.name = name.data();
+      ref.nameSize = (v_int32) name.size();
+      ref.hash = hash(ref.name, ref.nameSize);
+    }
+  }
+  for(auto& instruction : m_instructions) {
+    if(instruction.opcode == SELECT_FIELDS) {
+      buildNameTable(instruction);
+    }
+  }
+  m_resolvedProperties.resize(m_instructions.size());
+}
+
+void CompiledPath::buildNameTable(Instruction& instruction) {
+
+  FieldRef* refs = &m_fields[instruction.fieldsBegin];
+
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+    if(refs[i].type == Path::FieldReference::Type::NAME) {
+      for(v_int32 j = 0; j < i; j ++) {
+        if(refs[j].type == Path::FieldReference::Type::NAME && refs[j].firstOccurrence == j &&
+           m_names[refs[j].nameIndex] == m_names[refs[i].nameIndex])
+        {
+          refs[i].firstOccurrence = j;
+          break;
+        }
+      }
+      if(refs[i].firstOccurrence == i) {
+        instruction.namesCount ++;
+      }
+    }
+  }
+
+  if(instruction.namesCount == 0) {
+    return;
+  }
+
+  v_int32 tableSize = 2;
+  while(tableSize < instruction.namesCount * 2) {
+    tableSize <<= 1;
+  }
+
+  instruction.nameTableBegin = (v_int32) m_nameTable.size();
+  instruction.nameTableMask = tableSize - 1;
+  m_nameTable.resize(m_nameTable.size() + tableSize, -1);
+
+  v_int32* table = &m_nameTable[instruction.nameTableBegin];
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+    if(refs[i].type == Path::FieldReference::Type::NAME && refs[i].firstOccurrence == i) {
+      v_uint64 slot = refs[i].hash & instruction.nameTableMask;
+      while(table[slot] != -1) {
+        slot = (slot + 1) & instruction.nameTableMask;
+      }
+      table[slot] = i;
+    }
+  }
+
+}
+
+v_int32 CompiledPath::findName(const Instruction& instruction, const char* name, v_int32 size, v_uint64 hash) const {
+
+  if(instruction.namesCount == 0) {
+    return -1;
+  }
+
+  const v_int32* table = &m_nameTable[instruction.nameTableBegin];
+  const FieldRef* refs = &m_fields[instruction.fieldsBegin];
+
+  v_uint64 slot = hash & instruction.nameTableMask;
+  while(table[slot] != -1) {
+    const FieldRef& ref = refs[table[slot]];
+    if(ref.hash == hash && ref.nameSize == size && std::memcmp(ref.name, name, size) == 0) {
+      return table[slot];
+    }
+    slot = (slot + 1) & instruction.nameTableMask;
+  }
+
+  return -1;
+
+}
+
+const std::vector<CompiledPath::PropertySlot>* CompiledPath::resolveProperties(const Instruction& instruction, const Type* type) const {
+
+  v_int32 instructionIndex = (v_int32) (&instruction - m_instructions.data());
+
+  std::lock_guard<std::mutex> lock(m_resolvedPropertiesMutex);
+
+  auto& resolved = m_resolvedProperties[instructionIndex];
+  auto it = resolved.find(type);
+  if(it != resolved.end()) {
+    return &it->second;
+  }
+
+  const auto& map = type->properties->getMap();
+  const auto& list = type->properties->getList();
+
+  std::vector<Property*> byPosition(list.begin(), list.end());
+  std::vector<IndexSlot> indexes;
+  std::vector<v_int32> refSlots;
+  v_int32 slotsCount = resolveIndexes(instruction, (v_int64) byPosition.size(), indexes, refSlots);
+
+  std::vector<PropertySlot> slots(slotsCount, PropertySlot{nullptr, -1, -1});
+
+  auto refs = getFields(instruction);
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+    if(refs[i].type == Path::FieldReference::Type::NAME) {
+      auto found = map.find(m_names[refs[i].nameIndex]);
+      if(found != map.end()) {
+        slots[refSlots[i]] = PropertySlot{found->second, -1, i};
+      }
+    } else {
+      for(v_int32 slot = refSlots[i]; slot < refSlots[i + 1]; slot ++) {
+        slots[slot].ref = i;
+      }
+    }
+  }
+
+  for(const auto& index : indexes) {
+    slots[index.slot].property = byPosition[index.position];
+    slots[index.slot].index = index.position;
+  }
+
+  /* unordered_map never relocates its values - pointers to resolved vectors stay valid */
+  auto& properties = resolved[type];
+  for(const auto& slot : slots) {
+    if(slot.property) {
+      properties.push_back(slot);
+    }
+  }
+
+  return &properties;
+
+}
+
+v_int32 CompiledPath::resolveIndexes(const Instruction& instruction, v_int64 count, std::vector<IndexSlot>& indexes, std::vector<v_int32>& refSlots) const {
+
+  auto refs = getFields(instruction);
+
+  indexes.clear();
+  refSlots.resize(instruction.fieldsCount + 1);
+
+  if(!instruction.dynamicIndexes) {
+    auto sorted = getSortedIndexes(instruction);
+    for(v_int32 i = 0; i < instruction.sortedIndexesCount; i ++) {
+      const auto& ref = refs[sorted[i]];
+      if(ref.index >= count) {
+        break;
+      }
+      indexes.push_back(IndexSlot{ref.index, sorted[i]});
+    }
+    for(v_int32 i = 0; i <= instruction.fieldsCount; i ++) {
+      refSlots[i] = i;
+    }
+    return instruction.fieldsCount;
+  }
+
+  v_int32 slot = 0;
+
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+
+    const auto& ref = refs[i];
+    refSlots[i] = slot;
+
+    switch(ref.type) {
+
+      case Path::FieldReference::Type::INDEX: {
+        v_int64 position = ref.index < 0 ? ref.index + count : ref.index;
+        if(position >= 0 && position < count) {
+          indexes.push_back(IndexSlot{position, slot});
+        }
+        slot ++;
+        break;
+      }
+
+      case Path::FieldReference::Type::SLICE: {
+        Path::Slice slice((ref.flags & FLAG_SLICE_HAS_START) != 0, ref.index, (ref.flags & FLAG_SLICE_HAS_END) != 0, ref.end, ref.step);
+        v_int64 position;
+        v_int64 size = slice.resolve(count, position);
+        for(v_int64 k = 0; k < size; k ++) {
+          indexes.push_back(IndexSlot{position, slot ++});
+          position += ref.step;
+        }
+        break;
+      }
+
+      default:
+        slot ++;
+        break;
+
+    }
+
+  }
+
+  refSlots[instruction.fieldsCount] = slot;
+
+  std::sort(indexes.begin(), indexes.end(), [](const IndexSlot& a, const IndexSlot& b) {
+    return a.position < b.position || (a.position == b.position && a.slot < b.slot);
+  });
+
+  return slot;
+
+}
+
+const std::vector<CompiledPath::PropertySlot>& CompiledPath::getProperties(const Instruction& instruction, const Type* type, PropertyCacheLine& cacheLine) const {
+  if(cacheLine.type != type) {
+    cacheLine.properties = resolveProperties(instruction, type);
+    cacheLine.type = type;
+  }
+  return *cacheLine.properties;
+}
+std::shared_ptr<CompiledPath> CompiledPath::compile(const std::shared_ptr<Path>& path) {
+  return std::make_shared<CompiledPath>(path);
+}
+
+std::shared_ptr<CompiledPath> CompiledPath::compileSelection(const std::shared_ptr<Path::FieldCollection>& fields) {
+  if(fields) {
+    auto plan = std::make_shared<CompiledPath>(nullptr);
+    plan->addSelection(0, fields->getFields());
+    plan->finalize();
+    return plan;
+  }
+  return compile(Path::Builder().variable(nullptr).buildShared());
+}
+
+v_uint64 CompiledPath::hash(const char* data, v_int32 size) {
+  /* FNV-1a */
+  v_uint64 result = 14695981039346656037ULL;
+  for(v_int32 i = 0; i < size; i ++) {
+    result ^= (v_uint8) data[i];
+    result *= 1099511628211ULL;
+  }
+  return result;
+}
+
+const Predicate* CompiledPath::getPredicate(const Instruction& instruction) const {
+  if(instruction.predicate < 0) {
+    return nullptr;
+  }
+  return m_predicates[instruction.predicate].get();
+}
+
+v_int32 CompiledPath::getVariableLevel(const std::string& name) const {
+  for(const auto& variable : m_variables) {
+    if(variable.first == name) {
+      return variable.second;
+    }
+  }
+  return -1;
+}
+
+std::shared_ptr<Path> CompiledPath::getPath() const {
+  return m_path;
+}
+
+const CompiledPath::Instruction* CompiledPath::getInstructions() const {
+  return m_instructions.data();
+}
+
+v_int32 CompiledPath::getInstructionsCount() const {
+  return (v_int32) m_instructions.size();
+}
+
+const CompiledPath::FieldRef* CompiledPath::getFields(const Instruction& instruction) const {
+  return m_fields.data() + instruction.fieldsBegin;
+}
+
+const v_int32* CompiledPath::getSortedIndexes(const Instruction& instruction) const {
+  return m_sortedIndexes.data() + instruction.sortedIndexesBegin;
+}
+
+const std::string& CompiledPath::getName(const FieldRef& field) const {
+  return m_names[field.nameIndex];
+}
+
+const oatpp::String& CompiledPath::getNameString(const FieldRef& field) const {
+  return m_nameStrings[field.nameIndex];
+}
+
+}}
@@ -0,0 +1,200 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_dtoql_CompiledPath_hpp
+#define oatpp_dtoql_CompiledPath_hpp
+
+#include "./Predicate.hpp"
+
+#include "oatpp/core/data/mapping/type/Type.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Execution plan lowered from &l:Path;. <br>
+ * Components are flattened into a contiguous array of plain instructions. Field names are pre-hashed
+ * and index references are pre-sorted, so executing a plan never touches `shared_ptr<Component>`. <br>
+ * Index and slice references are resolved into output slots - a slice takes as many slots as positions it selects,
+ * any other reference takes one slot. Selections are emitted in slot order. <br>
+ * `FILTER` is lowered to `SELECT_ALL` with a &l:Predicate; tested on each selected field before it is expanded. <br>
+ * `RECURSIVE_DESCENT` is lowered to `SELECT_DESCENDANTS` - the value and its descendants up to `maxDepth` as one selection. <br>
+ * `RE_ROOT` and `FIELD_SELECTOR` components carry no runtime semantics and are dropped during compilation.
+ */
+class CompiledPath {
+public:
+  typedef oatpp::data::mapping::type::Type Type;
+  typedef oatpp::data::mapping::type::Type::Property Property;
+public:
+
+  enum OpCode : v_int32 {
+    SELECT_ALL = 0,
+    SELECT_FIELDS = 1,
+    SELECT_DESCENDANTS = 2
+  };
+
+  struct FieldRef {
+    v_int32 type;
+    v_int32 nameIndex;
+    const char* name;
+    v_int32 nameSize;
+    v_int64 index;
+    v_int64 end;
+    v_int64 step;
+    v_int32 flags;
+    v_uint64 hash;
+    v_int32 firstOccurrence;
+  };
+
+  static constexpr v_int32 FLAG_SLICE_HAS_START = 1;
+  static constexpr v_int32 FLAG_SLICE_HAS_END = 2;
+
+  struct Instruction {
+    v_int32 opcode;
+    v_int32 componentIndex;
+    v_int32 fieldsBegin;
+    v_int32 fieldsCount;
+    v_int32 sortedIndexesBegin;
+    v_int32 sortedIndexesCount;
+    v_int32 namesCount;
+    v_int32 nameTableBegin;
+    v_int32 nameTableMask;
+    v_int32 dynamicIndexes;
+    v_int32 predicate;
+    v_int32 maxDepth;
+  };
+
+  struct IndexSlot {
+    v_int64 position;
+    v_int32 slot;
+  };
+
+  struct PropertySlot {
+    Property* property;
+    v_int64 index;
+    v_int32 ref;
+  };
+
+  /**
+   * Inline cache of object properties resolution. Owned by an executor, one line per instruction. <br>
+   * Hit costs one pointer comparison. On miss the line is refilled from the plan-wide per-type cache.
+   */
+  struct PropertyCacheLine {
+    const Type* type;
+    const std::vector<PropertySlot>* properties;
+  };
+
+private:
+  typedef std::unordered_map<const Type*, std::vector<PropertySlot>> ResolvedProperties;
+private:
+  std::shared_ptr<Path> m_path;
+  std::vector<Instruction> m_instructions;
+  std::vector<FieldRef> m_fields;
+  std::vector<v_int32> m_sortedIndexes;
+  std::vector<v_int32> m_nameTable;
+  std::vector<std::string> m_names;
+  std::vector<oatpp::String> m_nameStrings;
+  std::vector<std::shared_ptr<Predicate>> m_predicates;
+  std::vector<std::pair<std::string, v_int32>> m_variables;
+private:
+  mutable std::mutex m_resolvedPropertiesMutex;
+  mutable std::vector<ResolvedProperties> m_resolvedProperties;
+private:
+  void addSelection(v_int32 componentIndex, const std::vector<Path::FieldReference>& fields);
+  void finalize();
+  void buildNameTable(Instruction& instruction);
+  const std::vector<PropertySlot>* resolveProperties(const Instruction& instruction, const Type* type) const;
+public:
+
+  CompiledPath(const std::shared_ptr<Path>& path);
+
+  static std::shared_ptr<CompiledPath> compile(const std::shared_ptr<Path>& path);
+  static std::shared_ptr<CompiledPath> compileSelection(const std::shared_ptr<Path::FieldCollection>& fields);
+
+  static v_uint64 hash(const char* data, v_int32 size);
+
+  std::shared_ptr<Path> getPath() const;
+
+  const Instruction* getInstructions() const;
+  v_int32 getInstructionsCount() const;
+
+  const FieldRef* getFields(const Instruction& instruction) const;
+  const v_int32* getSortedIndexes(const Instruction& instruction) const;
+
+  /**
+   * Find name reference of SELECT_FIELDS instruction in the pre-built open addressing table.
+   * @param instruction - instruction.
+   * @param name - name data.
+   * @param size - name size.
+   * @param hash - name hash as returned by &l:CompiledPath::hash ();.
+   * @return - position of the first reference with this name in &l:CompiledPath::getFields (); or `-1`.
+   */
+  v_int32 findName(const Instruction& instruction, const char* name, v_int32 size, v_uint64 hash) const;
+
+  /**
+   * Get predicate of the instruction.
+   * @param instruction - instruction.
+   * @return - &l:Predicate; or `nullptr` if instruction has no filter.
+   */
+  const Predicate* getPredicate(const Instruction& instruction) const;
+
+  /**
+   * Get level of row field bound to the named variable (`$name`).
+   * @param name - variable name without `$`.
+   * @return - level or `-1` if the path has no such variable.
+   */
+  v_int32 getVariableLevel(const std::string& name) const;
+
+  const std::string& getName(const FieldRef& field) const;
+  const oatpp::String& getNameString(const FieldRef& field) const;
+
+  /**
+   * Resolve index and slice references of SELECT_FIELDS instruction against container of given size.
+   * @param instruction - instruction.
+   * @param count - number of elements in container.
+   * @param indexes - out. Valid positions with their output slots, sorted by position.
+   * @param refSlots - out. First slot of each reference. Has `fieldsCount + 1` elements, the last one is total slots count.
+   * @return - total slots count.
+   */
+  v_int32 resolveIndexes(const Instruction& instruction, v_int64 count, std::vector<IndexSlot>& indexes, std::vector<v_int32>& refSlots) const;
+
+  /**
+   * Get object properties selected by SELECT_FIELDS instruction in output order. <br>
+   * References not found in the type are skipped.
+   * @param instruction - instruction.
+   * @param type - object type.
+   * @param cacheLine - executor-owned &l:CompiledPath::PropertyCacheLine; for this instruction.
+   * @return - selected properties.
+   */
+  const std::vector<PropertySlot>& getProperties(const Instruction& instruction, const Type* type, PropertyCacheLine& cacheLine) const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_CompiledPath_hpp
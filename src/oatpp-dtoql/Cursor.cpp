@@ -0,0 +1,98 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Cursor.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+Cursor::Cursor(const std::vector<v_int32>& positions)
+  : m_positions(positions)
+{}
+
+Cursor Cursor::parse(const oatpp::String& text) {
+
+  std::vector<v_int32> positions;
+
+  if(!text || text->getSize() == 0) {
+    return Cursor();
+  }
+
+  const char* data = (const char*) text->getData();
+  const char* end = data + text->getSize();
+
+  while(true) {
+
+    if(data == end || *data < '0' || *data > '9') {
+      throw std::runtime_error("[oatpp::dtoql::Cursor::parse()]: Error. Invalid cursor.");
+    }
+
+    v_int64 position = 0;
+    while(data < end && *data >= '0' && *data <= '9') {
+      position = position * 10 + (*data - '0');
+      if(position > 0x7FFFFFFF) {
+        throw std::runtime_error("[oatpp::dtoql::Cursor::parse()]: Error. Position is out of range.");
+      }
+      data ++;
+    }
+    positions.push_back((v_int32) position);
+
+    if(data == end) {
+      break;
+    }
+    if(*data != '.') {
+      throw std::runtime_error("[oatpp::dtoql::Cursor::parse()]: Error. Invalid cursor.");
+    }
+    data ++;
+
+  }
+
+  return Cursor(positions);
+
+}
+
+oatpp::String Cursor::toString() const {
+  std::string result;
+  for(size_t i = 0; i < m_positions.size(); i ++) {
+    if(i > 0) {
+      result.push_back('.');
+    }
+    result.append(std::to_string(m_positions[i]));
+  }
+  return oatpp::String(result.data(), (v_int32) result.size(), true);
+}
+
+const std::vector<v_int32>& Cursor::getPositions() const {
+  return m_positions;
+}
+
+bool Cursor::isEmpty() const {
+  return m_positions.empty();
+}
+
+}}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Cursor_hpp
+#define oatpp_dtoql_Cursor_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Position of a row in the query - position of the row field in the selection of each level, starting with the root. <br>
+ * Query started from a cursor continues right after its row without revisiting preceding rows. <br>
+ * Text form - positions separated by `.`, e.g. `0.1.0.42`. Empty cursor - beginning of the query.
+ */
+class Cursor {
+private:
+  std::vector<v_int32> m_positions;
+public:
+
+  /**
+   * Constructor. Beginning of the query.
+   */
+  Cursor() = default;
+
+  /**
+   * Constructor.
+   * @param positions - positions per level.
+   */
+  Cursor(const std::vector<v_int32>& positions);
+
+  /**
+   * Parse text form.
+   * @param text - text produced by &l:Cursor::toString ();.
+   * @return - &l:Cursor;.
+   * @throws - `std::runtime_error` if text is not a valid cursor.
+   */
+  static Cursor parse(const oatpp::String& text);
+
+  /**
+   * Get text form.
+   * @return - &id:oatpp::String;.
+   */
+  oatpp::String toString() const;
+
+  const std::vector<v_int32>& getPositions() const;
+
+  /**
+   * Check if cursor points to the beginning of the query.
+   * @return - `true` if empty.
+   */
+  bool isEmpty() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Cursor_hpp
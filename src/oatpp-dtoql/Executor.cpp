@@ -0,0 +1,783 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Executor.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// FieldView
+
+oatpp::String Executor::FieldView::getName() const {
+  if(nameString) {
+    return *nameString;
+  }
+  if(name) {
+    return oatpp::String(name, nameSize, true);
+  }
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Row
+
+Executor::Row::Row(const Frame* frames, v_int32 size, v_int32 changedLevel, const CompiledPath* plan)
+  : m_frames(frames)
+  , m_size(size)
+  , m_changedLevel(changedLevel)
+  , m_plan(plan)
+{}
+
+v_int32 Executor::Row::getSize() const {
+  return m_size;
+}
+
+v_int32 Executor::Row::getChangedLevel() const {
+  return m_changedLevel;
+}
+
+const Executor::FieldView& Executor::Row::operator[](v_int32 level) const {
+  const Frame& frame = m_frames[level];
+  return frame.fields[frame.position - 1];
+}
+
+const Executor::FieldView* Executor::Row::getBinding(const std::string& name) const {
+  v_int32 level = m_plan ? m_plan->getVariableLevel(name) : -1;
+  if(level < 0 || level >= m_size) {
+    return nullptr;
+  }
+  return &(*this)[level];
+}
+
+bool Executor::Row::isDescendant(v_int32 level) const {
+  if(m_plan == nullptr || level < 1 || level > m_plan->getInstructionsCount()) {
+    return false;
+  }
+  return m_plan->getInstructions()[level - 1].opcode == CompiledPath::SELECT_DESCENDANTS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Executor
+
+Executor::Executor(v_int64 arenaChunkSize)
+  : m_mapIndexCache(nullptr)
+  , m_arena(arenaChunkSize)
+  , m_root(nullptr)
+  , m_changedLevel(0)
+  , m_hasRow(false)
+  , m_stats(nullptr)
+  , m_valueIndexes(nullptr)
+  , m_childrenCacheLine{nullptr, nullptr}
+{}
+
+Executor::Executor(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, MapIndexCache* mapIndexCache)
+  : Executor()
+{
+  start(plan, root, mapIndexCache);
+}
+
+void Executor::setPlan(const std::shared_ptr<CompiledPath>& plan) {
+  if(m_plan != plan) {
+    m_propertyCache.assign(plan->getInstructionsCount(), CompiledPath::PropertyCacheLine{nullptr, nullptr});
+    m_plan = plan;
+  }
+}
+
+void Executor::start(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, MapIndexCache* mapIndexCache) {
+
+  setPlan(plan);
+
+  m_mapIndexCache = mapIndexCache;
+  m_root = root;
+  m_rootField = FieldView{nullptr, 0, nullptr, 0, &m_root};
+
+  m_arena.reset();
+  m_frames.clear();
+  m_frames.reserve(m_plan->getInstructionsCount() + 1);
+  m_frames.push_back(Frame{&m_rootField, 1, 0, m_arena.getMark()});
+  m_changedLevel = 0;
+  m_hasRow = false;
+
+#ifndef OATPP_DTOQL_DISABLE_STATS
+  if(m_stats) {
+    m_stats->onQuery(m_plan);
+  }
+#endif
+
+}
+
+void Executor::start(const std::shared_ptr<CompiledPath>& plan, const FieldView* path, v_int32 level, const FieldView* fields, v_int32 count,
+                     MapIndexCache* mapIndexCache)
+{
+
+  if(level > plan->getInstructionsCount()) {
+    throw std::runtime_error("[oatpp::dtoql::Executor::start()]: Error. Start level is out of plan.");
+  }
+
+  setPlan(plan);
+
+  m_mapIndexCache = mapIndexCache;
+  m_root = nullptr;
+
+  m_arena.reset();
+  m_frames.clear();
+  m_frames.reserve(m_plan->getInstructionsCount() + 1);
+
+  auto mark = m_arena.getMark();
+
+  /* prefix frames are already consumed - when the last frame is exhausted the query is finished */
+
+  FieldView* prefix = m_arena.allocate<FieldView>(level);
+  for(v_int32 i = 0; i < level; i ++) {
+    prefix[i] = path[i];
+    m_frames.push_back(Frame{&prefix[i], 1, 1, mark});
+  }
+
+  FieldView* selection = m_arena.allocate<FieldView>(count);
+  for(v_int32 i = 0; i < count; i ++) {
+    selection[i] = fields[i];
+  }
+  m_frames.push_back(Frame{selection, count, 0, mark});
+
+  m_changedLevel = 0;
+  m_hasRow = false;
+
+#ifndef OATPP_DTOQL_DISABLE_STATS
+  if(m_stats) {
+    m_stats->onQuery(m_plan);
+  }
+#endif
+
+}
+
+void Executor::start(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const Cursor& cursor,
+                     MapIndexCache* mapIndexCache)
+{
+
+  start(plan, root, mapIndexCache);
+
+  const auto& positions = cursor.getPositions();
+  if(positions.empty()) {
+    return;
+  }
+
+  v_int32 leafLevel = m_plan->getInstructionsCount();
+  if((v_int32) positions.size() != leafLevel + 1 || positions[0] != 0) {
+    throw std::runtime_error("[oatpp::dtoql::Executor::start()]: Error. Cursor doesn't match the plan.");
+  }
+
+  /* rebuild frames as they were right after the cursor row was returned */
+
+  m_frames[0].position = 1;
+
+  for(v_int32 level = 1; level <= leafLevel; level ++) {
+
+    const Frame& parent = m_frames[level - 1];
+
+    Frame child;
+    child.mark = m_arena.getMark();
+    child.size = select(level - 1, *parent.fields[parent.position - 1].value, child.fields);
+
+    if(positions[level] >= child.size) {
+      child.position = child.size;
+      m_frames.push_back(child);
+      break;
+    }
+
+    child.position = positions[level] + 1;
+    m_frames.push_back(child);
+
+  }
+
+}
+
+void Executor::select(const std::shared_ptr<CompiledPath>& plan, v_int32 level, const AbstractObjectWrapper& value, std::vector<FieldView>& result) {
+
+  setPlan(plan);
+
+  auto mark = m_arena.getMark();
+  FieldView* fields;
+  v_int32 count = select(level, value, fields);
+  result.assign(fields, fields + count);
+  m_arena.rewind(mark);
+
+}
+
+v_int32 Executor::selectInList(const AbstractList* list, const CompiledPath::Instruction& instruction, FieldView*& result) {
+
+  if(instruction.opcode == CompiledPath::SELECT_FIELDS) {
+
+    v_int32 slotsCount = m_plan->resolveIndexes(instruction, list->count(), m_indexes, m_refSlots);
+    result = m_arena.allocate<FieldView>(slotsCount);
+    for(v_int32 slot = 0; slot < slotsCount; slot ++) {
+      result[slot].value = nullptr;
+    }
+
+    /* resolve all positions in one forward walk, then compact in the requested order */
+
+    auto node = list->getFirstNode();
+    v_int64 position = 0;
+
+    for (const auto& index : m_indexes) {
+      while (position < index.position) {
+        node = node->getNext();
+        position ++;
+      }
+      const auto& data = node->getData();
+      if(data) {
+        result[index.slot] = FieldView{nullptr, 0, nullptr, position, &data};
+      }
+    }
+
+    v_int32 count = 0;
+    for (v_int32 slot = 0; slot < slotsCount; slot ++) {
+      if (result[slot].value) {
+        result[count ++] = result[slot];
+      }
+    }
+    return count;
+
+  }
+
+  result = m_arena.allocate<FieldView>(list->count());
+
+  v_int32 count = 0;
+  auto node = list->getFirstNode();
+  v_int64 index = 0;
+  while(node != nullptr) {
+    const auto& data = node->getData();
+    if(data) {
+      result[count ++] = FieldView{nullptr, 0, nullptr, index, &data};
+    }
+    index ++;
+    node = node->getNext();
+  }
+  return count;
+
+}
+
+v_int32 Executor::selectInMap(const AbstractFieldsMap::ObjectWrapper& map, const CompiledPath::Instruction& instruction, FieldView*& result) {
+
+  if(instruction.opcode == CompiledPath::SELECT_FIELDS) {
+
+    auto refs = m_plan->getFields(instruction);
+    v_int32 slotsCount = m_plan->resolveIndexes(instruction, map->count(), m_indexes, m_refSlots);
+
+    /* entries are resolved into slots first, then emitted in reference order - duplicate names share a slot */
+
+    FieldView* slots = m_arena.allocate<FieldView>(slotsCount);
+    result = m_arena.allocate<FieldView>(slotsCount);
+    for(v_int32 slot = 0; slot < slotsCount; slot ++) {
+      slots[slot].value = nullptr;
+    }
+
+    const MapIndex* index = m_mapIndexCache ? m_mapIndexCache->getIndex(map) : nullptr;
+
+    if(index) {
+
+      for (const auto& i : m_indexes) {
+        auto entry = index->getEntry((v_int32) i.position);
+        slots[i.slot] = FieldView{nullptr, 0, &entry->getKey(), i.position, &entry->getValue()};
+      }
+
+      for (v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+        const auto& f = refs[i];
+        if(f.type == Path::FieldReference::Type::NAME && f.firstOccurrence == i) {
+          v_int32 position = index->find(f.name, f.nameSize, f.hash);
+          if(position >= 0) {
+            auto entry = index->getEntry(position);
+            slots[m_refSlots[i]] = FieldView{nullptr, 0, &entry->getKey(), position, &entry->getValue()};
+          }
+        }
+      }
+
+    } else {
+
+      /* resolve all requested names and indexes in one ordered pass over the map */
+
+      v_int32 k = 0;
+      v_int32 indexesCount = (v_int32) m_indexes.size();
+      v_int32 namesPending = instruction.namesCount;
+
+      auto currEntry = map->getFirstEntry();
+      v_int64 position = 0;
+
+      while (currEntry != nullptr && (namesPending > 0 || k < indexesCount)) {
+
+        while (k < indexesCount && m_indexes[k].position == position) {
+          slots[m_indexes[k].slot] = FieldView{nullptr, 0, &currEntry->getKey(), position, &currEntry->getValue()};
+          k ++;
+        }
+
+        const auto& key = currEntry->getKey();
+        if (namesPending > 0 && key) {
+          const char* keyData = (const char*) key->getData();
+          v_int32 i = m_plan->findName(instruction, keyData, key->getSize(), CompiledPath::hash(keyData, key->getSize()));
+          if (i >= 0 && slots[m_refSlots[i]].value == nullptr) {
+            slots[m_refSlots[i]] = FieldView{nullptr, 0, &key, position, &currEntry->getValue()};
+            namesPending --;
+          }
+        }
+
+        position ++;
+        currEntry = currEntry->getNext();
+
+      }
+
+    }
+
+    v_int32 count = 0;
+    for (v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+      v_int32 begin = m_refSlots[i];
+      v_int32 end = m_refSlots[i + 1];
+      if(refs[i].type == Path::FieldReference::Type::NAME) {
+        begin = m_refSlots[refs[i].firstOccurrence];
+        end = begin + 1;
+      }
+      for (v_int32 slot = begin; slot < end; slot ++) {
+        FieldView& view = slots[slot];
+        if (view.value) {
+          const auto& key = *view.nameString;
+          if(key) {
+            view.name = (const char*) key->getData();
+            view.nameSize = key->getSize();
+          }
+          result[count ++] = view;
+        }
+      }
+    }
+    return count;
+
+  }
+
+  result = m_arena.allocate<FieldView>(map->count());
+
+  v_int32 count = 0;
+  auto currEntry = map->getFirstEntry();
+  v_int64 index = 0;
+  while(currEntry != nullptr) {
+    const auto& key = currEntry->getKey();
+    if(key) {
+      result[count ++] = FieldView{(const char*) key->getData(), key->getSize(), &key, index, &currEntry->getValue()};
+    } else {
+      result[count ++] = FieldView{nullptr, 0, &key, index, &currEntry->getValue()};
+    }
+    index ++;
+    currEntry = currEntry->getNext();
+  }
+  return count;
+
+}
+
+v_int32 Executor::selectInObject(Object* object, const Type* type, const CompiledPath::Instruction& instruction,
+                                 CompiledPath::PropertyCacheLine& cacheLine, FieldView*& result)
+{
+
+  const v_char8* base = (const v_char8*) object;
+
+  if(instruction.opcode == CompiledPath::SELECT_FIELDS) {
+
+    auto refs = m_plan->getFields(instruction);
+    const auto& properties = m_plan->getProperties(instruction, type, cacheLine);
+
+    result = m_arena.allocate<FieldView>(properties.size());
+
+    v_int32 count = 0;
+    for (const auto& p : properties) {
+      const auto& f = refs[p.ref];
+      auto value = (const AbstractObjectWrapper*) (base + p.property->offset);
+      if (f.type == Path::FieldReference::Type::NAME) {
+        result[count ++] = FieldView{f.name, f.nameSize, &m_plan->getNameString(f), -1, value};
+      } else {
+        result[count ++] = FieldView{p.property->name, (v_int32) std::strlen(p.property->name), nullptr, p.index, value};
+      }
+    }
+    return count;
+
+  }
+
+  auto& fields = type->properties->getList();
+  result = m_arena.allocate<FieldView>(fields.size());
+
+  v_int32 count = 0;
+  for (auto const &field : fields) {
+    auto value = (const AbstractObjectWrapper*) (base + field->offset);
+    result[count] = FieldView{field->name, (v_int32) std::strlen(field->name), nullptr, count, value};
+    count ++;
+  }
+  return count;
+
+}
+
+bool Executor::isContainer(const AbstractObjectWrapper& value) {
+  if(!value) {
+    return false;
+  }
+  auto classId = value.valueType->classId.id;
+  return classId == oatpp::data::mapping::type::__class::AbstractList::CLASS_ID.id ||
+         classId == oatpp::data::mapping::type::__class::AbstractListMap::CLASS_ID.id ||
+         classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID.id;
+}
+
+v_int32 Executor::selectChildren(const AbstractObjectWrapper& value, FieldView*& result) {
+
+  static const CompiledPath::Instruction selectAll = {CompiledPath::SELECT_ALL, -1, 0, 0, 0, 0, 0, 0, 0, 0, -1, -1};
+
+  auto classId = value.valueType->classId.id;
+
+  if(classId == oatpp::data::mapping::type::__class::AbstractList::CLASS_ID.id) {
+    return selectInList(oatpp::data::mapping::type::static_wrapper_cast<AbstractList>(value).get(), selectAll, result);
+  } else if(classId == oatpp::data::mapping::type::__class::AbstractListMap::CLASS_ID.id) {
+    return selectInMap(oatpp::data::mapping::type::static_wrapper_cast<AbstractFieldsMap>(value), selectAll, result);
+  } else if(classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID.id) {
+    return selectInObject(oatpp::data::mapping::type::static_wrapper_cast<Object>(value).get(), value.valueType, selectAll, m_childrenCacheLine, result);
+  }
+
+  result = nullptr;
+  return 0;
+
+}
+
+v_int32 Executor::selectDescendants(const AbstractObjectWrapper& value, v_int32 maxDepth, FieldView*& result) {
+
+  /* iterative pre-order walk - depth of DTO graph is not limited by the call stack */
+
+  m_descentStack.clear();
+  m_descendants.clear();
+  m_visited.clear();
+
+  m_descentStack.push_back(Descent{FieldView{nullptr, 0, nullptr, -1, &value}, 0});
+
+  while(!m_descentStack.empty()) {
+
+    Descent descent = m_descentStack.back();
+    m_descentStack.pop_back();
+
+    const AbstractObjectWrapper& current = *descent.field.value;
+    bool container = isContainer(current);
+
+    if(container && !m_visited.insert(current.get())) {
+      continue; // shared or cyclic reference
+    }
+
+    m_descendants.push_back(descent.field);
+
+    if(container && (maxDepth < 0 || descent.depth < maxDepth)) {
+      auto mark = m_arena.getMark();
+      FieldView* children;
+      v_int32 count = selectChildren(current, children);
+      for(v_int32 i = count - 1; i >= 0; i --) {
+        m_descentStack.push_back(Descent{children[i], descent.depth + 1});
+      }
+      m_arena.rewind(mark);
+    }
+
+  }
+
+  result = m_arena.allocate<FieldView>(m_descendants.size());
+  for(size_t i = 0; i < m_descendants.size(); i ++) {
+    result[i] = m_descendants[i];
+  }
+  return (v_int32) m_descendants.size();
+
+}
+
+bool Executor::selectIndexed(const CompiledPath::Instruction& instruction, const AbstractObjectWrapper& value, FieldView*& result, v_int32& count) {
+
+  auto comparison = m_plan->getPredicate(instruction)->getIndexableComparison();
+  if(comparison == nullptr) {
+    return false;
+  }
+
+  auto index = m_valueIndexes->find(value.get(), comparison->operand);
+  if(index == nullptr || !index->lookup(*comparison, m_indexedElements)) {
+    return false;
+  }
+
+  /* candidates only - the predicate is still applied to them */
+
+  count = (v_int32) m_indexedElements.size();
+  result = m_arena.allocate<FieldView>(count);
+  for(v_int32 i = 0; i < count; i ++) {
+    const auto& element = index->getElement(m_indexedElements[i]);
+    const oatpp::String* key = element.key;
+    if(key && *key) {
+      result[i] = FieldView{(const char*) (*key)->getData(), (*key)->getSize(), key, element.index, element.value};
+    } else {
+      result[i] = FieldView{nullptr, 0, key, element.index, element.value};
+    }
+  }
+  return true;
+
+}
+
+v_int32 Executor::selectFields(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result) {
+
+  result = nullptr;
+
+  if(!value) {
+    return 0;
+  }
+
+  const auto& instruction = m_plan->getInstructions()[level];
+
+  if(instruction.opcode == CompiledPath::SELECT_DESCENDANTS) {
+    return selectDescendants(value, instruction.maxDepth, result);
+  }
+
+  v_int32 count;
+  if(m_valueIndexes && instruction.predicate >= 0 && selectIndexed(instruction, value, result, count)) {
+    return count;
+  }
+
+  auto classId = value.valueType->classId.id;
+
+  if(classId == oatpp::data::mapping::type::__class::AbstractList::CLASS_ID.id) {
+    // List
+    return selectInList(oatpp::data::mapping::type::static_wrapper_cast<AbstractList>(value).get(), instruction, result);
+  } else if(classId == oatpp::data::mapping::type::__class::AbstractListMap::CLASS_ID.id) {
+    // Map
+    return selectInMap(oatpp::data::mapping::type::static_wrapper_cast<AbstractFieldsMap>(value), instruction, result);
+  } else if(classId == oatpp::data::mapping::type::__class::AbstractObject::CLASS_ID.id) {
+    // Object
+    return selectInObject(oatpp::data::mapping::type::static_wrapper_cast<Object>(value).get(), value.valueType, instruction, m_propertyCache[level], result);
+  }
+
+  return 0;
+
+}
+
+v_int32 Executor::applyPredicate(v_int32 level, v_int32 count, FieldView* result) {
+
+  /* filter before the fields are expanded - rejected subtrees are never visited */
+  auto predicate = m_plan->getPredicate(m_plan->getInstructions()[level]);
+  if(predicate) {
+    v_int32 matched = 0;
+    for(v_int32 i = 0; i < count; i ++) {
+      if(predicate->test(*result[i].value)) {
+        result[matched ++] = result[i];
+      }
+    }
+    count = matched;
+  }
+
+  return count;
+
+}
+
+v_int32 Executor::selectMeasured(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result) {
+
+  auto begin = std::chrono::steady_clock::now();
+  v_int64 capacity = m_arena.getCapacity();
+
+  v_int32 selected = selectFields(level, value, result);
+  v_int32 count = applyPredicate(level, selected, result);
+
+  auto& stats = m_stats->getComponentStats(level);
+  stats.visits ++;
+  stats.selected += count;
+  stats.rejected += selected - count;
+  if(selected == 0) {
+    stats.misses ++;
+  }
+  stats.allocated += m_arena.getCapacity() - capacity;
+  stats.time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+
+  return count;
+
+}
+
+v_int32 Executor::select(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result) {
+#ifndef OATPP_DTOQL_DISABLE_STATS
+  if(m_stats) {
+    return selectMeasured(level, value, result);
+  }
+#endif
+  v_int32 count = selectFields(level, value, result);
+  return applyPredicate(level, count, result);
+}
+
+Executor::Status Executor::advance(v_int64& budget) {
+
+  v_int32 leafLevel = m_plan ? m_plan->getInstructionsCount() : 0;
+
+  /* changed level accumulates over yields until the next row */
+  if(m_hasRow) {
+    m_changedLevel = leafLevel;
+    m_hasRow = false;
+  }
+
+  while(!m_frames.empty()) {
+
+    if(budget == 0) {
+      return YIELD;
+    }
+    budget --;
+
+    Frame& frame = m_frames.back();
+    v_int32 level = (v_int32) m_frames.size() - 1;
+
+    if(frame.position == frame.size) {
+      m_arena.rewind(frame.mark);
+      m_frames.pop_back();
+      continue;
+    }
+
+    const FieldView& field = frame.fields[frame.position ++];
+
+    if(level < m_changedLevel) {
+      m_changedLevel = level;
+    }
+
+    if(level == leafLevel) {
+      m_hasRow = true;
+#ifndef OATPP_DTOQL_DISABLE_STATS
+      if(m_stats) {
+        m_stats->onRow();
+      }
+#endif
+      return ROW;
+    }
+
+    Frame child;
+    child.mark = m_arena.getMark();
+    child.position = 0;
+    child.size = select(level, *field.value, child.fields);
+    m_frames.push_back(child);
+
+  }
+
+  return FINISHED;
+
+}
+
+bool Executor::next() {
+  v_int64 budget = -1;
+  return advance(budget) == ROW;
+}
+
+Executor::Row Executor::getRow() const {
+  return Row(m_frames.data(), (v_int32) m_frames.size(), m_changedLevel, m_plan.get());
+}
+
+Cursor Executor::getCursor() const {
+
+  if(!m_hasRow) {
+    throw std::runtime_error("[oatpp::dtoql::Executor::getCursor()]: Error. No current row.");
+  }
+
+  std::vector<v_int32> positions(m_frames.size());
+  for(size_t i = 0; i < m_frames.size(); i ++) {
+    positions[i] = m_frames[i].position - 1;
+  }
+  return Cursor(positions);
+
+}
+
+v_int64 Executor::skip(v_int64 count) {
+  v_int64 skipped = 0;
+  while(skipped < count && next()) {
+    skipped ++;
+  }
+  return skipped;
+}
+
+v_int64 Executor::run(RowVisitor& visitor, v_int64 limit) {
+  v_int64 count = 0;
+  while(count != limit && next()) {
+    if(count == 0) {
+      m_changedLevel = 0; // the visitor has not seen rows skipped or fetched before
+    }
+    count ++;
+    if(visitor.onRow(getRow()) == RowVisitor::STOP) {
+      break;
+    }
+  }
+  return count;
+}
+
+v_int64 Executor::execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, RowVisitor& visitor,
+                          MapIndexCache* mapIndexCache)
+{
+  Executor executor(plan, root, mapIndexCache);
+  return executor.run(visitor);
+}
+
+v_int64 Executor::execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const RowCallback& callback,
+                          MapIndexCache* mapIndexCache)
+{
+  CallbackRowVisitor visitor(callback);
+  return execute(plan, root, visitor, mapIndexCache);
+}
+
+v_int64 Executor::execute(const std::shared_ptr<Path>& path, const AbstractObjectWrapper& root, RowVisitor& visitor) {
+  return execute(CompiledPath::compile(path), root, visitor, nullptr);
+}
+
+v_int64 Executor::execute(const std::shared_ptr<Path>& path, const AbstractObjectWrapper& root, const RowCallback& callback) {
+  CallbackRowVisitor visitor(callback);
+  return execute(CompiledPath::compile(path), root, visitor, nullptr);
+}
+
+v_int64 Executor::executePage(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, Cursor& cursor,
+                              v_int64 offset, v_int64 limit, RowVisitor& visitor, MapIndexCache* mapIndexCache)
+{
+
+  Executor executor;
+  executor.start(plan, root, cursor, mapIndexCache);
+
+  if(executor.skip(offset) < offset) {
+    return 0;
+  }
+
+  v_int64 count = executor.run(visitor, limit);
+  if(executor.m_hasRow) {
+    cursor = executor.getCursor();
+  }
+  return count;
+
+}
+
+void Executor::setStats(QueryStats* stats) {
+  m_stats = stats;
+}
+
+void Executor::setValueIndexes(const ValueIndexSet* indexes) {
+  m_valueIndexes = indexes;
+}
+
+std::shared_ptr<CompiledPath> Executor::getPlan() const {
+  return m_plan;
+}
+
+const Arena& Executor::getArena() const {
+  return m_arena;
+}
+
+}}
@@ -0,0 +1,383 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Executor_hpp
+#define oatpp_dtoql_Executor_hpp
+
+#include "./Arena.hpp"
+#include "./CompiledPath.hpp"
+#include "./Cursor.hpp"
+#include "./MapIndex.hpp"
+#include "./QueryStats.hpp"
+#include "./ValueIndex.hpp"
+#include "./VisitedSet.hpp"
+
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/data/mapping/type/List.hpp"
+#include "oatpp/core/data/mapping/type/Object.hpp"
+#include "oatpp/core/data/mapping/type/Type.hpp"
+
+#include "oatpp/core/Types.hpp"
+
+#include <functional>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Depth-first executor of &l:CompiledPath;. <br>
+ * Selections are written to a monotonic &l:Arena; as contiguous frames of borrowed &l:Executor::FieldView;s -
+ * one frame per level. Frames are released as soon as their level is exhausted. <br>
+ * Executor is reusable - once its arena and scratch buffers have grown to the working set of a query,
+ * subsequent queries of similar shape do not allocate.
+ */
+class Executor {
+public:
+  typedef oatpp::data::mapping::type::Type Type;
+  typedef oatpp::data::mapping::type::Object Object;
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+  typedef oatpp::data::mapping::type::List<AbstractObjectWrapper> AbstractList;
+  typedef oatpp::data::mapping::type::ListMap<oatpp::String, AbstractObjectWrapper> AbstractFieldsMap;
+public:
+
+  /**
+   * Non-owning view of a selected field. <br>
+   * Pointers are valid as long as the root object is alive and not modified.
+   */
+  struct FieldView {
+
+    /**
+     * Map key or object property name. `nullptr` for list elements.
+     */
+    const char* name;
+    v_int32 nameSize;
+
+    /**
+     * String holding the name if there is one (map key, or name from the query), `nullptr` otherwise.
+     */
+    const oatpp::String* nameString;
+
+    v_int64 index;
+    const AbstractObjectWrapper* value;
+
+    /**
+     * Get name as &id:oatpp::String;. Allocates only if the name is not held by a String already.
+     * @return
+     */
+    oatpp::String getName() const;
+
+  };
+
+  struct Frame {
+    FieldView* fields;
+    v_int32 size;
+    v_int32 position;
+    Arena::Mark mark;
+  };
+
+  /**
+   * Current row of the executor - one field per level, starting with the root. <br>
+   * Valid until the next call to &l:Executor::next ();.
+   */
+  class Row {
+  private:
+    const Frame* m_frames;
+    v_int32 m_size;
+    v_int32 m_changedLevel;
+    const CompiledPath* m_plan;
+  public:
+
+    Row(const Frame* frames, v_int32 size, v_int32 changedLevel, const CompiledPath* plan);
+
+    v_int32 getSize() const;
+
+    /**
+     * Lowest level whose field differs from the previous row. Fields above it are shared with the previous row.
+     * @return - level. `0` for the first row.
+     */
+    v_int32 getChangedLevel() const;
+
+    const FieldView& operator[](v_int32 level) const;
+
+    /**
+     * Get field bound to the named variable (`$name`) of the path. Rows of &l:QuerySet; have no bindings.
+     * @param name - variable name without `$`.
+     * @return - field or `nullptr` if the path has no such variable.
+     */
+    const FieldView* getBinding(const std::string& name) const;
+
+    /**
+     * Check if the field was selected by recursive descent (`..`) - then it has siblings from different depths,
+     * named and unnamed. Always `false` for rows of &l:QuerySet;.
+     * @param level - level of the field.
+     * @return
+     */
+    bool isDescendant(v_int32 level) const;
+
+  };
+
+  /**
+   * Push-style consumer of rows. See &l:Executor::run ();.
+   */
+  class RowVisitor {
+  public:
+
+    enum Action : v_int32 {
+      CONTINUE = 0,
+      STOP = 1
+    };
+
+  public:
+
+    virtual ~RowVisitor() = default;
+
+    /**
+     * Called for each row.
+     * @param row - &l:Executor::Row;. Valid only for the duration of the call.
+     * @return - &l:Executor::RowVisitor::Action;.
+     */
+    virtual Action onRow(const Row& row) = 0;
+
+  };
+
+  typedef std::function<RowVisitor::Action (const Row&)> RowCallback;
+
+  enum Status : v_int32 {
+    ROW = 0,
+    YIELD = 1,
+    FINISHED = 2
+  };
+
+private:
+
+  class CallbackRowVisitor : public RowVisitor {
+  private:
+    const RowCallback& m_callback;
+  public:
+    CallbackRowVisitor(const RowCallback& callback) : m_callback(callback) {}
+    Action onRow(const Row& row) override {
+      return m_callback(row);
+    }
+  };
+
+  struct Descent {
+    FieldView field;
+    v_int32 depth;
+  };
+
+private:
+  static bool isContainer(const AbstractObjectWrapper& value);
+private:
+  v_int32 selectInList(const AbstractList* list, const CompiledPath::Instruction& instruction, FieldView*& result);
+  v_int32 selectInMap(const AbstractFieldsMap::ObjectWrapper& map, const CompiledPath::Instruction& instruction, FieldView*& result);
+  v_int32 selectInObject(Object* object, const Type* type, const CompiledPath::Instruction& instruction,
+                         CompiledPath::PropertyCacheLine& cacheLine, FieldView*& result);
+  v_int32 selectChildren(const AbstractObjectWrapper& value, FieldView*& result);
+  v_int32 selectDescendants(const AbstractObjectWrapper& value, v_int32 maxDepth, FieldView*& result);
+  bool selectIndexed(const CompiledPath::Instruction& instruction, const AbstractObjectWrapper& value, FieldView*& result, v_int32& count);
+  v_int32 selectFields(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result);
+  v_int32 applyPredicate(v_int32 level, v_int32 count, FieldView* result);
+  v_int32 selectMeasured(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result);
+  v_int32 select(v_int32 level, const AbstractObjectWrapper& value, FieldView*& result);
+  void setPlan(const std::shared_ptr<CompiledPath>& plan);
+private:
+  std::shared_ptr<CompiledPath> m_plan;
+  MapIndexCache* m_mapIndexCache;
+  Arena m_arena;
+  AbstractObjectWrapper m_root;
+  FieldView m_rootField;
+  std::vector<Frame> m_frames;
+  v_int32 m_changedLevel;
+  bool m_hasRow;
+  std::vector<CompiledPath::PropertyCacheLine> m_propertyCache;
+  std::vector<CompiledPath::IndexSlot> m_indexes;
+  std::vector<v_int32> m_refSlots;
+  QueryStats* m_stats;
+  const ValueIndexSet* m_valueIndexes;
+  std::vector<v_int32> m_indexedElements;
+  std::vector<Descent> m_descentStack;
+  std::vector<FieldView> m_descendants;
+  VisitedSet m_visited;
+  CompiledPath::PropertyCacheLine m_childrenCacheLine;
+public:
+
+  /**
+   * Constructor. Call &l:Executor::start (); to run a query.
+   * @param arenaChunkSize - chunk size of the &l:Arena;.
+   */
+  Executor(v_int64 arenaChunkSize = 64 * 1024);
+
+  /**
+   * Constructor. Starts the query right away.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   */
+  Executor(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, MapIndexCache* mapIndexCache = nullptr);
+
+  Executor(const Executor& other) = delete;
+  Executor& operator=(const Executor& other) = delete;
+
+  /**
+   * Start new query. Abandons the current one, if any.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object. Held by the executor until the next query.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, MapIndexCache* mapIndexCache = nullptr);
+
+  /**
+   * Start query in the middle of the plan. <br>
+   * Rows consist of the `path` fields followed by one of `fields` and fields selected below it.
+   * Used to split a query into independent parts.
+   * @param plan - &l:CompiledPath;.
+   * @param path - fields of levels `0 .. level - 1`. Copied. Values must outlive the query.
+   * @param level - level of `fields`.
+   * @param fields - fields to start from. Copied.
+   * @param count - number of fields.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const FieldView* path, v_int32 level, const FieldView* fields, v_int32 count,
+             MapIndexCache* mapIndexCache = nullptr);
+
+  /**
+   * Resume query right after the row of the cursor. <br>
+   * Only the selections along the cursor path are made - preceding rows are not visited.
+   * If the data has changed and a cursor position is out of its selection, the query continues after that selection.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param cursor - &l:Cursor; obtained from &l:Executor::getCursor (); for the same plan. Empty - start from the beginning.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   * @throws - `std::runtime_error` if cursor doesn't match the plan.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const Cursor& cursor,
+             MapIndexCache* mapIndexCache = nullptr);
+
+  /**
+   * Select fields of the value by plan instruction at level. <br>
+   * Does not affect the query in progress, unless called with a different plan.
+   * @param plan - &l:CompiledPath;.
+   * @param level - instruction index.
+   * @param value - value to select from.
+   * @param result - out. Selected fields.
+   */
+  void select(const std::shared_ptr<CompiledPath>& plan, v_int32 level, const AbstractObjectWrapper& value, std::vector<FieldView>& result);
+
+  /**
+   * Advance to the next row spending at most `budget` steps. <br>
+   * A step is one field visited or one exhausted frame released.
+   * @param budget - in/out. Steps allowed, decremented by the steps taken. Negative - unlimited.
+   * @return - &l:Executor::Status;. `ROW` - row is available via &l:Executor::getRow ();,
+   * `YIELD` - budget is spent, call again to resume, `FINISHED` - no more rows.
+   */
+  Status advance(v_int64& budget);
+
+  /**
+   * Advance to the next row.
+   * @return - `true` if there is a row. `false` if the query is finished.
+   */
+  bool next();
+
+  /**
+   * Get current row.
+   * @return - &l:Executor::Row;.
+   */
+  Row getRow() const;
+
+  /**
+   * Get position of the current row.
+   * @return - &l:Cursor;.
+   * @throws - `std::runtime_error` if there is no current row.
+   */
+  Cursor getCursor() const;
+
+  /**
+   * Skip rows.
+   * @param count - number of rows to skip.
+   * @return - number of rows skipped. Less than `count` if the query is finished.
+   */
+  v_int64 skip(v_int64 count);
+
+  /**
+   * Push remaining rows of the current query to visitor. The first row pushed has changed level `0`.
+   * @param visitor - &l:Executor::RowVisitor;.
+   * @param limit - max number of rows to visit. Negative - no limit.
+   * @return - number of rows visited.
+   */
+  v_int64 run(RowVisitor& visitor, v_int64 limit = -1);
+
+  /**
+   * Execute query streaming rows to visitor. Nothing is materialized.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param visitor - &l:Executor::RowVisitor;. Return `STOP` to terminate early.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   * @return - number of rows visited.
+   */
+  static v_int64 execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, RowVisitor& visitor,
+                         MapIndexCache* mapIndexCache = nullptr);
+
+  static v_int64 execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const RowCallback& callback,
+                         MapIndexCache* mapIndexCache = nullptr);
+
+  static v_int64 execute(const std::shared_ptr<Path>& path, const AbstractObjectWrapper& root, RowVisitor& visitor);
+
+  static v_int64 execute(const std::shared_ptr<Path>& path, const AbstractObjectWrapper& root, const RowCallback& callback);
+
+  /**
+   * Execute one page of the query. Traversal stops as soon as the page is full.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param cursor - in/out. &l:Cursor; to resume after. Set to the last visited row, left unchanged if the query is finished.
+   * @param offset - number of rows to skip before the page.
+   * @param limit - page size.
+   * @param visitor - &l:Executor::RowVisitor;.
+   * @param mapIndexCache - optional &l:MapIndexCache;. Not owned.
+   * @return - number of rows visited. Less than `limit` if the query is finished.
+   */
+  static v_int64 executePage(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, Cursor& cursor,
+                             v_int64 offset, v_int64 limit, RowVisitor& visitor, MapIndexCache* mapIndexCache = nullptr);
+
+  /**
+   * Collect &l:QueryStats; of the queries started after this call. <br>
+   * Has no effect if compiled with `-D OATPP_DTOQL_DISABLE_STATS`.
+   * @param stats - stats to fill. Not owned. `nullptr` - stop collecting.
+   */
+  void setStats(QueryStats* stats);
+
+  /**
+   * Use value indexes to select candidates of filters - see &l:ValueIndex;.
+   * @param indexes - &l:ValueIndexSet;. Not owned. `nullptr` - always scan.
+   */
+  void setValueIndexes(const ValueIndexSet* indexes);
+
+  std::shared_ptr<CompiledPath> getPlan() const;
+
+  const Arena& getArena() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Executor_hpp
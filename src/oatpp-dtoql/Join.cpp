@@ -0,0 +1,195 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Join.hpp"
+
+#include "./ValueUtils.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Source
+
+Join::Source::Source(const std::shared_ptr<CompiledPath>& pPlan, const AbstractObjectWrapper& pRoot,
+                     const oatpp::String& pVariable, const std::vector<oatpp::String>& pKey)
+  : plan(pPlan)
+  , root(pRoot)
+  , variable(pVariable ? pVariable->std_str() : "")
+{
+  for(const auto& name : pKey) {
+    key.push_back(name ? name->std_str() : "");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Row
+
+Join::Row::Row(const FieldView* fields, v_int32 size, const CompiledPath* plan)
+  : m_fields(fields)
+  , m_size(size)
+  , m_plan(plan)
+{}
+
+v_int32 Join::Row::getSize() const {
+  return m_size;
+}
+
+const Join::FieldView& Join::Row::operator[](v_int32 level) const {
+  return m_fields[level];
+}
+
+const Join::FieldView* Join::Row::getBinding(const std::string& name) const {
+  v_int32 level = m_plan->getVariableLevel(name);
+  if(level < 0 || level >= m_size) {
+    return nullptr;
+  }
+  return &m_fields[level];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Join
+
+void Join::start(const Source& source, Table& table) {
+
+  table.level = source.plan->getVariableLevel(source.variable);
+  if(table.level < 0) {
+    throw std::runtime_error("[oatpp::dtoql::Join::execute()]: Error. Path has no variable '$" + source.variable + "'.");
+  }
+
+  table.source = &source;
+  table.root = source.root;
+  table.executor.start(source.plan, source.root);
+
+}
+
+bool Join::fetch(Table& table) {
+
+  while(table.executor.next()) {
+
+    auto row = table.executor.getRow();
+    auto key = Predicate::resolve(row[table.level].value, table.source->key);
+
+    Record record;
+    if(key == nullptr || !ValueUtils::hash(*key, record.hash)) {
+      continue;
+    }
+    record.key = key;
+    record.begin = (v_int32) table.fields.size();
+    record.size = row.getSize();
+
+    /* field views point into the DTO, except for the root which is held by the executor -
+     * it is at level 0 and at every level selected by descent of depth 0 */
+    for(v_int32 i = 0; i < row.getSize(); i ++) {
+      FieldView field = row[i];
+      if(field.value == row[0].value) {
+        field.value = &table.root;
+      }
+      table.fields.push_back(field);
+    }
+
+    table.records.push_back(record);
+    return true;
+
+  }
+
+  return false;
+
+}
+
+v_int64 Join::execute(const Source& left, const Source& right, const Callback& callback) {
+
+  Table leftTable;
+  Table rightTable;
+  start(left, leftTable);
+  start(right, rightTable);
+
+  /* the side which is done first has fewer rows - it is the build side */
+  bool buildLeft;
+  while(true) {
+    if(!fetch(leftTable)) {
+      buildLeft = true;
+      break;
+    }
+    if(!fetch(rightTable)) {
+      buildLeft = false;
+      break;
+    }
+  }
+
+  const Table& build = buildLeft ? leftTable : rightTable;
+  Table& probe = buildLeft ? rightTable : leftTable;
+
+  std::unordered_map<v_uint64, std::vector<v_int32>> buckets;
+  buckets.reserve(build.records.size());
+  for(v_int32 i = 0; i < (v_int32) build.records.size(); i ++) {
+    buckets[build.records[i].hash].push_back(i);
+  }
+
+  v_int64 count = 0;
+
+  size_t probeIndex = 0;
+  while(true) {
+
+    /* rows of the probe side fetched so far are probed first, then the rest of them one by one */
+    if(probeIndex == probe.records.size()) {
+      probe.records.clear();
+      probe.fields.clear();
+      probeIndex = 0;
+      if(!fetch(probe)) {
+        break;
+      }
+    }
+
+    const auto& probeRecord = probe.records[probeIndex ++];
+
+    auto it = buckets.find(probeRecord.hash);
+    if(it == buckets.end()) {
+      continue;
+    }
+
+    Row probeRow(&probe.fields[probeRecord.begin], probeRecord.size, probe.source->plan.get());
+
+    for(v_int32 i : it->second) {
+      const auto& buildRecord = build.records[i];
+      if(!ValueUtils::equals(*probeRecord.key, *buildRecord.key)) {
+        continue;
+      }
+      Row buildRow(&build.fields[buildRecord.begin], buildRecord.size, build.source->plan.get());
+      count ++;
+      if(!(buildLeft ? callback(buildRow, probeRow) : callback(probeRow, buildRow))) {
+        return count;
+      }
+    }
+
+  }
+
+  return count;
+
+}
+
+}}
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Join_hpp
+#define oatpp_dtoql_Join_hpp
+
+#include "./Executor.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Equi-join of rows of two paths on values bound to named variables -
+ * e.g. rows of `['orders']$o` and `['customers']$c` where `$o.customerId == $c.id`. <br>
+ * Executed as a hash join: both sides are executed in turns, row by row, until one of them is done -
+ * the hash table is built on that side (the one with fewer rows), and the rest of the other side is streamed
+ * against it. Memory is bounded by twice the rows of the smaller side. <br>
+ * Keys are compared with &l:ValueUtils::equals ();. Rows with missing or `null` keys are not joined. <br>
+ * Pairs are emitted in order of the probe side rows, then of the build side rows.
+ */
+class Join {
+public:
+  typedef Executor::AbstractObjectWrapper AbstractObjectWrapper;
+  typedef Executor::FieldView FieldView;
+public:
+
+  /**
+   * Side of the join.
+   */
+  class Source {
+  public:
+    std::shared_ptr<CompiledPath> plan;
+    AbstractObjectWrapper root;
+    std::string variable;
+    std::vector<std::string> key;
+  public:
+
+    /**
+     * Constructor.
+     * @param pPlan - path with the named variable.
+     * @param pRoot - root object.
+     * @param pVariable - variable name without `$`.
+     * @param pKey - operand relative to the bound field, as in filter expression. Empty - the bound value itself.
+     */
+    Source(const std::shared_ptr<CompiledPath>& pPlan, const AbstractObjectWrapper& pRoot,
+           const oatpp::String& pVariable, const std::vector<oatpp::String>& pKey);
+
+  };
+
+  /**
+   * Row of one side.
+   */
+  class Row {
+  private:
+    const FieldView* m_fields;
+    v_int32 m_size;
+    const CompiledPath* m_plan;
+  public:
+
+    Row(const FieldView* fields, v_int32 size, const CompiledPath* plan);
+
+    v_int32 getSize() const;
+
+    const FieldView& operator[](v_int32 level) const;
+
+    /**
+     * Get field bound to the named variable.
+     * @param name - variable name without `$`.
+     * @return - field or `nullptr`.
+     */
+    const FieldView* getBinding(const std::string& name) const;
+
+  };
+
+  /**
+   * Called for each joined pair. Return `false` to stop.
+   */
+  typedef std::function<bool (const Row& left, const Row& right)> Callback;
+
+private:
+
+  struct Record {
+    v_int32 begin;
+    v_int32 size;
+    v_uint64 hash;
+    const AbstractObjectWrapper* key;
+  };
+
+  struct Table {
+    const Source* source;
+    AbstractObjectWrapper root;
+    Executor executor;
+    v_int32 level;
+    std::vector<FieldView> fields;
+    std::vector<Record> records;
+    Table() : source(nullptr), root(nullptr), level(-1) {}
+  };
+
+private:
+  static void start(const Source& source, Table& table);
+  static bool fetch(Table& table);
+public:
+
+  /**
+   * Execute join.
+   * @param left - left side.
+   * @param right - right side.
+   * @param callback - &l:Join::Callback;.
+   * @return - number of joined pairs visited.
+   * @throws - `std::runtime_error` if a path has no such variable.
+   */
+  static v_int64 execute(const Source& left, const Source& right, const Callback& callback);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Join_hpp
@@ -0,0 +1,404 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "JsonExecutor.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Value
+
+JsonExecutor::Value::Type JsonExecutor::Value::getType() const {
+  switch(data[0]) {
+    case 'n': return NULL_VALUE;
+    case 't':
+    case 'f': return BOOLEAN;
+    case '"': return STRING;
+    case '[': return ARRAY;
+    case '{': return OBJECT;
+    default: return NUMBER;
+  }
+}
+
+bool JsonExecutor::Value::isNull() const {
+  return data[0] == 'n';
+}
+
+bool JsonExecutor::Value::getBoolean() const {
+  return data[0] == 't';
+}
+
+v_int64 JsonExecutor::Value::getInteger() const {
+  char buffer[32];
+  v_int32 length = size < 31 ? size : 31;
+  std::memcpy(buffer, data, length);
+  buffer[length] = 0;
+  return std::strtoll(buffer, nullptr, 10);
+}
+
+v_float64 JsonExecutor::Value::getFloat() const {
+  char buffer[64];
+  v_int32 length = size < 63 ? size : 63;
+  std::memcpy(buffer, data, length);
+  buffer[length] = 0;
+  return std::strtod(buffer, nullptr);
+}
+
+oatpp::String JsonExecutor::Value::getString() const {
+  if(getType() != STRING || size < 2) {
+    return nullptr;
+  }
+  std::string result;
+  if(!JsonScanner::unescape(data + 1, size - 2, result)) {
+    throw std::runtime_error("[oatpp::dtoql::JsonExecutor::Value::getString()]: Error. Invalid escape sequence.");
+  }
+  return oatpp::String(result.data(), (v_int32) result.size(), true);
+}
+
+oatpp::String JsonExecutor::Value::getRaw() const {
+  return oatpp::String(data, size, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Field
+
+oatpp::String JsonExecutor::Field::getName() const {
+  if(name == nullptr) {
+    return nullptr;
+  }
+  std::string result;
+  if(!JsonScanner::unescape(name, nameSize, result)) {
+    throw std::runtime_error("[oatpp::dtoql::JsonExecutor::Field::getName()]: Error. Invalid escape sequence.");
+  }
+  return oatpp::String(result.data(), (v_int32) result.size(), true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Row
+
+JsonExecutor::Row::Row(const JsonExecutor* executor)
+  : m_executor(executor)
+{}
+
+v_int32 JsonExecutor::Row::getSize() const {
+  return (v_int32) m_executor->m_frames.size();
+}
+
+v_int32 JsonExecutor::Row::getChangedLevel() const {
+  return m_executor->m_changedLevel;
+}
+
+const JsonExecutor::Field& JsonExecutor::Row::operator[](v_int32 level) const {
+  const Frame& frame = m_executor->m_frames[level];
+  return m_executor->m_fields[frame.begin + frame.position - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// JsonExecutor
+
+JsonExecutor::JsonExecutor()
+  : m_data(nullptr)
+  , m_end(nullptr)
+  , m_changedLevel(0)
+  , m_hasRow(false)
+{}
+
+void JsonExecutor::fail(const char* p) const {
+  throw std::runtime_error("[oatpp::dtoql::JsonExecutor::next()]: Error. Malformed JSON at position " +
+                           std::to_string(p ? p - m_data : m_end - m_data) + ".");
+}
+
+void JsonExecutor::start(const std::shared_ptr<CompiledPath>& plan, const char* data, v_int64 size) {
+
+  for(v_int32 i = 0; i < plan->getInstructionsCount(); i ++) {
+    if(plan->getInstructions()[i].predicate >= 0) {
+      throw std::runtime_error("[oatpp::dtoql::JsonExecutor::start()]: Error. Filters are not supported over JSON.");
+    }
+  }
+
+  m_plan = plan;
+  m_data = data;
+  m_end = data + size;
+
+  /* root span is not validated here - containers are checked when scanned */
+  const char* begin = JsonScanner::skipBlank(m_data, m_end);
+  const char* end = m_end;
+  while(end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+    end --;
+  }
+  if(begin == end) {
+    fail(begin);
+  }
+
+  m_fields.clear();
+  m_frames.clear();
+  m_fields.push_back(Field{nullptr, 0, 0, Value{begin, (v_int32) (end - begin)}});
+  m_frames.push_back(Frame{0, 1, 0});
+  m_changedLevel = 0;
+  m_hasRow = false;
+
+}
+
+void JsonExecutor::start(const std::shared_ptr<CompiledPath>& plan, const oatpp::String& text) {
+  m_text = text;
+  start(plan, (const char*) text->getData(), text->getSize());
+}
+
+v_int32 JsonExecutor::collectMembers(const Value& value) {
+
+  m_members.clear();
+
+  bool isObject = value.data[0] == '{';
+  char close = isObject ? '}' : ']';
+  const char* end = value.data + value.size;
+  const char* p = JsonScanner::skipBlank(value.data + 1, end);
+
+  if(p < end && *p == close) {
+    return 0;
+  }
+
+  while(p < end) {
+
+    Member member{nullptr, 0, Value{nullptr, 0}};
+
+    if(isObject) {
+      if(*p != '"') {
+        fail(p);
+      }
+      const char* q = JsonScanner::skipString(p, end);
+      if(q == nullptr) {
+        fail(p);
+      }
+      member.name = p + 1;
+      member.nameSize = (v_int32) (q - p - 2);
+      p = JsonScanner::skipBlank(q, end);
+      if(p == end || *p != ':') {
+        fail(p);
+      }
+      p = JsonScanner::skipBlank(p + 1, end);
+    }
+
+    const char* q = JsonScanner::skipValue(p, end);
+    if(q == nullptr) {
+      fail(p);
+    }
+    member.value = Value{p, (v_int32) (q - p)};
+    m_members.push_back(member);
+
+    p = JsonScanner::skipBlank(q, end);
+    if(p < end && *p == ',') {
+      p = JsonScanner::skipBlank(p + 1, end);
+    } else if(p < end && *p == close && p + 1 == end) {
+      return (v_int32) m_members.size();
+    } else {
+      fail(p);
+    }
+
+  }
+
+  fail(p);
+  return 0;
+
+}
+
+void JsonExecutor::selectAll(const Value& value, bool isObject) {
+  v_int32 count = collectMembers(value);
+  for(v_int32 i = 0; i < count; i ++) {
+    const auto& member = m_members[i];
+    if(isObject || !member.value.isNull()) {
+      m_fields.push_back(Field{member.name, member.nameSize, i, member.value});
+    }
+  }
+}
+
+void JsonExecutor::selectFields(const CompiledPath::Instruction& instruction, const Value& value, bool isObject) {
+
+  v_int32 count = collectMembers(value);
+  auto refs = m_plan->getFields(instruction);
+  v_int32 slotsCount = m_plan->resolveIndexes(instruction, count, m_indexes, m_refSlots);
+
+  /* same slot resolution as maps in Executor - duplicate names share a slot */
+
+  m_slots.assign(slotsCount, Field{nullptr, 0, -1, Value{nullptr, 0}});
+
+  for(const auto& i : m_indexes) {
+    const auto& member = m_members[(size_t) i.position];
+    if(isObject || !member.value.isNull()) {
+      m_slots[i.slot] = Field{member.name, member.nameSize, i.position, member.value};
+    }
+  }
+
+  if(isObject && instruction.namesCount > 0) {
+    for(v_int32 position = 0; position < count; position ++) {
+      const auto& member = m_members[position];
+      const char* name = member.name;
+      v_int32 nameSize = member.nameSize;
+      if(std::memchr(name, '\\', nameSize) != nullptr) {
+        if(!JsonScanner::unescape(name, nameSize, m_name)) {
+          fail(name);
+        }
+        name = m_name.data();
+        nameSize = (v_int32) m_name.size();
+      }
+      v_int32 i = m_plan->findName(instruction, name, nameSize, CompiledPath::hash(name, nameSize));
+      if(i >= 0 && m_slots[m_refSlots[i]].value.data == nullptr) {
+        m_slots[m_refSlots[i]] = Field{member.name, member.nameSize, position, member.value};
+      }
+    }
+  }
+
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+    v_int32 begin = m_refSlots[i];
+    v_int32 end = m_refSlots[i + 1];
+    if(refs[i].type == Path::FieldReference::Type::NAME) {
+      begin = m_refSlots[refs[i].firstOccurrence];
+      end = begin + 1;
+    }
+    for(v_int32 slot = begin; slot < end; slot ++) {
+      if(m_slots[slot].value.data != nullptr) {
+        m_fields.push_back(m_slots[slot]);
+      }
+    }
+  }
+
+}
+
+void JsonExecutor::selectDescendants(const Value& value, v_int32 maxDepth) {
+
+  m_descentStack.clear();
+  m_descentStack.push_back(Descent{Field{nullptr, 0, -1, value}, 0});
+
+  while(!m_descentStack.empty()) {
+
+    Descent descent = m_descentStack.back();
+    m_descentStack.pop_back();
+
+    m_fields.push_back(descent.field);
+
+    auto type = descent.field.value.getType();
+    if((type == Value::OBJECT || type == Value::ARRAY) && (maxDepth < 0 || descent.depth < maxDepth)) {
+      v_int32 count = collectMembers(descent.field.value);
+      for(v_int32 i = count - 1; i >= 0; i --) {
+        const auto& member = m_members[i];
+        if(type == Value::OBJECT || !member.value.isNull()) {
+          m_descentStack.push_back(Descent{Field{member.name, member.nameSize, i, member.value}, descent.depth + 1});
+        }
+      }
+    }
+
+  }
+
+}
+
+void JsonExecutor::select(v_int32 level, const Value& value) {
+
+  auto type = value.getType();
+  const auto& instruction = m_plan->getInstructions()[level];
+
+  if(type == Value::NULL_VALUE) {
+    return;
+  }
+
+  if(instruction.opcode == CompiledPath::SELECT_DESCENDANTS) {
+    selectDescendants(value, instruction.maxDepth);
+    return;
+  }
+
+  if(type != Value::OBJECT && type != Value::ARRAY) {
+    return;
+  }
+
+  if(instruction.opcode == CompiledPath::SELECT_FIELDS) {
+    selectFields(instruction, value, type == Value::OBJECT);
+  } else {
+    selectAll(value, type == Value::OBJECT);
+  }
+
+}
+
+bool JsonExecutor::next() {
+
+  v_int32 leafLevel = m_plan ? m_plan->getInstructionsCount() : 0;
+
+  if(m_hasRow) {
+    m_changedLevel = leafLevel;
+    m_hasRow = false;
+  }
+
+  while(!m_frames.empty()) {
+
+    Frame& frame = m_frames.back();
+    v_int32 level = (v_int32) m_frames.size() - 1;
+
+    if(frame.position == frame.size) {
+      m_fields.resize(frame.begin);
+      m_frames.pop_back();
+      continue;
+    }
+
+    Value value = m_fields[frame.begin + frame.position].value;
+    frame.position ++;
+
+    if(level < m_changedLevel) {
+      m_changedLevel = level;
+    }
+
+    if(level == leafLevel) {
+      m_hasRow = true;
+      return true;
+    }
+
+    v_int32 begin = (v_int32) m_fields.size();
+    select(level, value);
+    m_frames.push_back(Frame{begin, (v_int32) m_fields.size() - begin, 0});
+
+  }
+
+  return false;
+
+}
+
+JsonExecutor::Row JsonExecutor::getRow() const {
+  return Row(this);
+}
+
+v_int64 JsonExecutor::execute(const std::shared_ptr<CompiledPath>& plan, const oatpp::String& text, const RowCallback& callback) {
+  JsonExecutor executor;
+  executor.start(plan, text);
+  v_int64 count = 0;
+  while(executor.next()) {
+    count ++;
+    if(!callback(executor.getRow())) {
+      break;
+    }
+  }
+  return count;
+}
+
+}}
@@ -0,0 +1,218 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_JsonExecutor_hpp
+#define oatpp_dtoql_JsonExecutor_hpp
+
+#include "./CompiledPath.hpp"
+#include "./JsonScanner.hpp"
+
+#include <functional>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Executor of &l:CompiledPath; over JSON text - same rows as &l:Executor; over the deserialized DTO,
+ * without deserializing. <br>
+ * Only containers on the selected paths are scanned, everything else is skipped by bracket matching (see &l:JsonScanner;).
+ * Values are byte spans of the source buffer, decoded on demand. <br>
+ * JSON objects are selected like maps. `null` array elements are skipped, same as `null` list elements. <br>
+ * Filters are not supported.
+ */
+class JsonExecutor {
+public:
+
+  /**
+   * Span of JSON value in the source buffer.
+   */
+  class Value {
+  public:
+
+    enum Type : v_int32 {
+      NULL_VALUE = 0,
+      BOOLEAN = 1,
+      NUMBER = 2,
+      STRING = 3,
+      ARRAY = 4,
+      OBJECT = 5
+    };
+
+  public:
+    const char* data;
+    v_int32 size;
+  public:
+
+    Type getType() const;
+
+    bool isNull() const;
+    bool getBoolean() const;
+    v_int64 getInteger() const;
+    v_float64 getFloat() const;
+
+    /**
+     * Get decoded string value.
+     * @return - &id:oatpp::String;. `nullptr` if value is not a string.
+     */
+    oatpp::String getString() const;
+
+    /**
+     * Get JSON text of the value.
+     * @return - &id:oatpp::String;.
+     */
+    oatpp::String getRaw() const;
+
+  };
+
+  struct Field {
+
+    /**
+     * Member name as it is in JSON, without quotes and not unescaped. `nullptr` for array elements.
+     */
+    const char* name;
+    v_int32 nameSize;
+
+    v_int64 index;
+    Value value;
+
+    /**
+     * Get decoded member name.
+     * @return - &id:oatpp::String;. `nullptr` for array elements.
+     */
+    oatpp::String getName() const;
+
+  };
+
+  /**
+   * Current row - one field per level, starting with the root. Valid until the next call to &l:JsonExecutor::next ();.
+   */
+  class Row {
+  private:
+    const JsonExecutor* m_executor;
+  public:
+
+    Row(const JsonExecutor* executor);
+
+    v_int32 getSize() const;
+
+    /**
+     * Lowest level whose field differs from the previous row.
+     * @return - level. `0` for the first row.
+     */
+    v_int32 getChangedLevel() const;
+
+    const Field& operator[](v_int32 level) const;
+
+  };
+
+  typedef std::function<bool (const Row&)> RowCallback;
+
+private:
+
+  struct Frame {
+    v_int32 begin;
+    v_int32 size;
+    v_int32 position;
+  };
+
+  struct Member {
+    const char* name;
+    v_int32 nameSize;
+    Value value;
+  };
+
+  struct Descent {
+    Field field;
+    v_int32 depth;
+  };
+
+private:
+  const char* parseContainer(const char* p, const char* end, bool isObject);
+  v_int32 collectMembers(const Value& value);
+  void selectAll(const Value& value, bool isObject);
+  void selectFields(const CompiledPath::Instruction& instruction, const Value& value, bool isObject);
+  void selectDescendants(const Value& value, v_int32 maxDepth);
+  void select(v_int32 level, const Value& value);
+  void fail(const char* p) const;
+private:
+  std::shared_ptr<CompiledPath> m_plan;
+  const char* m_data;
+  const char* m_end;
+  oatpp::String m_text;
+  std::vector<Field> m_fields;
+  std::vector<Frame> m_frames;
+  v_int32 m_changedLevel;
+  bool m_hasRow;
+  std::vector<Member> m_members;
+  std::vector<Field> m_slots;
+  std::vector<CompiledPath::IndexSlot> m_indexes;
+  std::vector<v_int32> m_refSlots;
+  std::vector<Descent> m_descentStack;
+  std::string m_name;
+public:
+
+  JsonExecutor();
+
+  JsonExecutor(const JsonExecutor& other) = delete;
+  JsonExecutor& operator=(const JsonExecutor& other) = delete;
+
+  /**
+   * Start new query.
+   * @param plan - &l:CompiledPath;.
+   * @param data - JSON text. Not copied - must outlive the query.
+   * @param size - text size.
+   * @throws - `std::runtime_error` if plan has filters or text is not a JSON value.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const char* data, v_int64 size);
+
+  /**
+   * Start new query.
+   * @param plan - &l:CompiledPath;.
+   * @param text - JSON text. Held by the executor until the next query.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const oatpp::String& text);
+
+  /**
+   * Advance to the next row.
+   * @return - `true` if there is a row.
+   * @throws - `std::runtime_error` if a scanned part of the text is malformed.
+   */
+  bool next();
+
+  Row getRow() const;
+
+  /**
+   * Execute query.
+   * @param plan - &l:CompiledPath;.
+   * @param text - JSON text.
+   * @param callback - called for each row. Return `false` to stop.
+   * @return - number of rows visited.
+   */
+  static v_int64 execute(const std::shared_ptr<CompiledPath>& plan, const oatpp::String& text, const RowCallback& callback);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_JsonExecutor_hpp
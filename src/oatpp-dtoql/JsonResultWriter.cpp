@@ -0,0 +1,265 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "JsonResultWriter.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/data/mapping/type/Primitive.hpp"
+
+#include <cmath>
+
+namespace oatpp { namespace dtoql {
+
+JsonResultWriter::JsonResultWriter(oatpp::data::stream::ConsistentOutputStream* stream, Mode mode,
+                                   const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+  : m_stream(stream)
+  , m_mode(mode)
+  , m_objectMapper(objectMapper)
+  , m_rowsCount(0)
+{}
+
+void JsonResultWriter::writeString(oatpp::data::stream::ConsistentOutputStream& stream, const char* data, v_int32 size) {
+
+  static const char* const hex = "0123456789abcdef";
+
+  stream.write("\"", 1);
+
+  v_int32 start = 0;
+  for(v_int32 i = 0; i < size; i ++) {
+
+    v_char8 a = (v_char8) data[i];
+    if(a >= 0x20 && a != '"' && a != '\\') {
+      continue;
+    }
+
+    stream.write(&data[start], i - start);
+    start = i + 1;
+
+    switch(a) {
+      case '"': stream.write("\\\"", 2); break;
+      case '\\': stream.write("\\\\", 2); break;
+      case '\b': stream.write("\\b", 2); break;
+      case '\f': stream.write("\\f", 2); break;
+      case '\n': stream.write("\\n", 2); break;
+      case '\r': stream.write("\\r", 2); break;
+      case '\t': stream.write("\\t", 2); break;
+      default: {
+        char escaped[6] = {'\\', 'u', '0', '0', hex[a >> 4], hex[a & 15]};
+        stream.write(escaped, 6);
+      }
+    }
+
+  }
+
+  stream.write(&data[start], size - start);
+  stream.write("\"", 1);
+
+}
+
+void JsonResultWriter::writeValue(const Executor::AbstractObjectWrapper& value) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(!value) {
+    m_stream->write("null", 4);
+    return;
+  }
+
+  auto classId = value.valueType->classId.id;
+
+  if(classId == type::__class::String::CLASS_ID.id) {
+    auto str = static_cast<oatpp::base::StrBuffer*>(value.get());
+    writeString(*m_stream, (const char*) str->getData(), str->getSize());
+  } else if(classId == type::__class::Int32::CLASS_ID.id) {
+    *m_stream << (v_int64) static_cast<type::Primitive<v_int32, type::__class::Int32>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int64::CLASS_ID.id) {
+    *m_stream << static_cast<type::Primitive<v_int64, type::__class::Int64>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int16::CLASS_ID.id) {
+    *m_stream << (v_int64) static_cast<type::Primitive<v_int16, type::__class::Int16>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int8::CLASS_ID.id) {
+    *m_stream << (v_int64) static_cast<type::Primitive<v_int8, type::__class::Int8>*>(value.get())->getValue();
+  } else if(classId == type::__class::Boolean::CLASS_ID.id) {
+    bool b = static_cast<type::Primitive<bool, type::__class::Boolean>*>(value.get())->getValue();
+    m_stream->write(b ? "true" : "false", b ? 4 : 5);
+  } else if(classId == type::__class::Float64::CLASS_ID.id || classId == type::__class::Float32::CLASS_ID.id) {
+    v_float64 number = classId == type::__class::Float64::CLASS_ID.id ?
+                       static_cast<type::Primitive<v_float64, type::__class::Float64>*>(value.get())->getValue() :
+                       static_cast<type::Primitive<v_float32, type::__class::Float32>*>(value.get())->getValue();
+    if(std::isfinite(number)) {
+      *m_stream << number;
+    } else {
+      m_stream->write("null", 4);
+    }
+  } else {
+    if(!m_objectMapper) {
+      m_objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+    }
+    *m_stream << m_objectMapper->writeToString(value);
+  }
+
+}
+
+void JsonResultWriter::putChar(v_char8 c) {
+  m_stream->write(&c, 1);
+}
+
+void JsonResultWriter::writeKey(const Executor::FieldView& field) {
+  if(field.name) {
+    writeString(*m_stream, field.name, field.nameSize);
+  } else {
+    m_stream->write("\"\"", 2);
+  }
+  putChar(':');
+}
+
+void JsonResultWriter::writeEntryKey(const Executor::FieldView& field) {
+  if(field.name) {
+    m_stream->write("{\"name\":", 8);
+    writeString(*m_stream, field.name, field.nameSize);
+    putChar(',');
+  } else if(field.index >= 0) {
+    m_stream->write("{\"index\":", 9);
+    *m_stream << field.index;
+    putChar(',');
+  } else {
+    putChar('{');
+  }
+  m_stream->write("\"value\":", 8);
+}
+
+void JsonResultWriter::close() {
+  if(m_containers.back() == 'e') {
+    /* array of entries - close the last entry */
+    if(m_counts.back() > 0) {
+      putChar('}');
+    }
+    putChar(']');
+    m_containers.pop_back();
+    m_counts.pop_back();
+    return;
+  }
+  putChar(m_containers.back() == '{' ? '}' : ']');
+  m_containers.pop_back();
+  m_counts.pop_back();
+}
+
+Executor::RowVisitor::Action JsonResultWriter::onRow(const Executor::Row& row) {
+
+  v_int32 size = row.getSize();
+
+  if(m_mode == FLAT) {
+    putChar(m_rowsCount == 0 ? '[' : ',');
+    writeValue(*row[size - 1].value);
+    m_rowsCount ++;
+    return CONTINUE;
+  }
+
+  if(size == 1) {
+    /* plan without selections - the root is the only row */
+    if(m_rowsCount == 0) {
+      writeValue(*row[0].value);
+    }
+    m_rowsCount ++;
+    return CONTINUE;
+  }
+
+  /* containers of values at levels >= changed level are complete */
+  v_int32 changedLevel = row.getChangedLevel();
+  while(m_containers.size() > changedLevel) {
+    close();
+  }
+
+  for(v_int32 level = changedLevel; level < size; level ++) {
+
+    const auto& field = row[level];
+
+    if(level > 0) {
+      v_char8 container = m_containers.back();
+      if(m_counts.back() ++ > 0) {
+        m_stream->write(container == 'e' ? "}," : ",", container == 'e' ? 2 : 1);
+      }
+      if(container == '{') {
+        writeKey(field);
+      } else if(container == 'e') {
+        writeEntryKey(field);
+      }
+    }
+
+    if(level == size - 1) {
+      writeValue(*field.value);
+    } else {
+      const auto& child = row[level + 1];
+      bool isObject = child.name != nullptr || child.nameString != nullptr;
+      if(row.isDescendant(level + 1)) {
+        m_containers.push_back('e');
+        putChar('[');
+      } else {
+        m_containers.push_back(isObject ? '{' : '[');
+        putChar(m_containers.back());
+      }
+      m_counts.push_back(0);
+    }
+
+  }
+
+  m_rowsCount ++;
+  return CONTINUE;
+
+}
+
+void JsonResultWriter::finish() {
+
+  if(m_rowsCount == 0) {
+    if(m_mode == FLAT) {
+      m_stream->write("[]", 2);
+    } else {
+      m_stream->write("null", 4);
+    }
+    return;
+  }
+
+  if(m_mode == FLAT) {
+    putChar(']');
+    return;
+  }
+
+  while(!m_containers.empty()) {
+    close();
+  }
+
+}
+
+v_int64 JsonResultWriter::write(oatpp::data::stream::ConsistentOutputStream* stream,
+                                const std::shared_ptr<CompiledPath>& plan,
+                                const Executor::AbstractObjectWrapper& root,
+                                Mode mode)
+{
+  JsonResultWriter writer(stream, mode);
+  v_int64 count = Executor::execute(plan, root, writer);
+  writer.finish();
+  return count;
+}
+
+}}
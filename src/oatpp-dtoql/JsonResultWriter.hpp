@@ -0,0 +1,105 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_JsonResultWriter_hpp
+#define oatpp_dtoql_JsonResultWriter_hpp
+
+#include "./Executor.hpp"
+
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+#include "oatpp/core/data/stream/Stream.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Writes rows to a stream as JSON while the query runs. Nothing is materialized. <br>
+ * `FLAT` - array of row leaf values. <br>
+ * `NESTED` - the selected part of the root - each level becomes an object (named fields) or an array (list elements)
+ * holding the selected children. Rows must come in executor order. <br>
+ * Fields selected by recursive descent come from different depths, so their names may mix with indexes and repeat -
+ * they are written as an array of entries `{"name":...,"value":...}`, `{"index":...,"value":...}`,
+ * or `{"value":...}` for the value the descent starts from. <br>
+ * Primitive leaves are written directly, other leaves are serialized with the object mapper.
+ * Call &l:JsonResultWriter::finish (); after the last row.
+ */
+class JsonResultWriter : public Executor::RowVisitor {
+public:
+
+  enum Mode : v_int32 {
+    FLAT = 0,
+    NESTED = 1
+  };
+
+private:
+  static void writeString(oatpp::data::stream::ConsistentOutputStream& stream, const char* data, v_int32 size);
+private:
+  void putChar(v_char8 c);
+  void writeValue(const Executor::AbstractObjectWrapper& value);
+  void writeKey(const Executor::FieldView& field);
+  void writeEntryKey(const Executor::FieldView& field);
+  void close();
+private:
+  oatpp::data::stream::ConsistentOutputStream* m_stream;
+  Mode m_mode;
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_objectMapper;
+  std::vector<v_char8> m_containers;
+  std::vector<v_int64> m_counts;
+  v_int64 m_rowsCount;
+public:
+
+  /**
+   * Constructor.
+   * @param stream - output stream. Not owned.
+   * @param mode - &l:JsonResultWriter::Mode;.
+   * @param objectMapper - mapper for non-primitive leaves. Json mapper with default config if `nullptr`.
+   */
+  JsonResultWriter(oatpp::data::stream::ConsistentOutputStream* stream, Mode mode = FLAT,
+                   const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper = nullptr);
+
+  Action onRow(const Executor::Row& row) override;
+
+  /**
+   * Close open arrays and objects. Writes `[]` (`FLAT`) or `null` (`NESTED`) if there were no rows.
+   */
+  void finish();
+
+  /**
+   * Execute query writing the result to stream.
+   * @param stream - output stream.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param mode - &l:JsonResultWriter::Mode;.
+   * @return - number of rows written.
+   */
+  static v_int64 write(oatpp::data::stream::ConsistentOutputStream* stream,
+                       const std::shared_ptr<CompiledPath>& plan,
+                       const Executor::AbstractObjectWrapper& root,
+                       Mode mode = FLAT);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_JsonResultWriter_hpp
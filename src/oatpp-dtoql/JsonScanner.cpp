@@ -0,0 +1,242 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "JsonScanner.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace dtoql {
+
+namespace {
+
+const v_uint64 ONES = 0x0101010101010101ULL;
+const v_uint64 HIGHS = 0x8080808080808080ULL;
+
+/* non-zero if any byte of the word equals c. May flag bytes above a matching one - callers re-check bytewise */
+inline v_uint64 hasByte(v_uint64 word, v_char8 c) {
+  v_uint64 x = word ^ (ONES * c);
+  return (x - ONES) & ~x & HIGHS;
+}
+
+inline v_uint64 loadWord(const char* p) {
+  v_uint64 word;
+  std::memcpy(&word, p, 8);
+  return word;
+}
+
+void appendUtf8(std::string& result, v_uint32 code) {
+  if(code < 0x80) {
+    result.push_back((char) code);
+  } else if(code < 0x800) {
+    result.push_back((char) (0xC0 | (code >> 6)));
+    result.push_back((char) (0x80 | (code & 0x3F)));
+  } else if(code < 0x10000) {
+    result.push_back((char) (0xE0 | (code >> 12)));
+    result.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+    result.push_back((char) (0x80 | (code & 0x3F)));
+  } else {
+    result.push_back((char) (0xF0 | (code >> 18)));
+    result.push_back((char) (0x80 | ((code >> 12) & 0x3F)));
+    result.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+    result.push_back((char) (0x80 | (code & 0x3F)));
+  }
+}
+
+bool parseHex4(const char* p, const char* end, v_uint32& code) {
+  if(end - p < 4) {
+    return false;
+  }
+  code = 0;
+  for(v_int32 i = 0; i < 4; i ++) {
+    char c = p[i];
+    code <<= 4;
+    if(c >= '0' && c <= '9') {
+      code |= (v_uint32) (c - '0');
+    } else if(c >= 'a' && c <= 'f') {
+      code |= (v_uint32) (c - 'a' + 10);
+    } else if(c >= 'A' && c <= 'F') {
+      code |= (v_uint32) (c - 'A' + 10);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+const char* JsonScanner::skipBlank(const char* p, const char* end) {
+  while(p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+    p ++;
+  }
+  return p;
+}
+
+const char* JsonScanner::skipString(const char* p, const char* end) {
+
+  p ++; // skip opening quote
+
+  while(p < end) {
+
+    if(end - p >= 8) {
+      v_uint64 word = loadWord(p);
+      if((hasByte(word, '"') | hasByte(word, '\\')) == 0) {
+        p += 8;
+        continue;
+      }
+    }
+
+    char c = *p;
+    if(c == '"') {
+      return p + 1;
+    }
+    if(c == '\\') {
+      p ++;
+    }
+    p ++;
+
+  }
+
+  return nullptr;
+
+}
+
+const char* JsonScanner::skipValue(const char* p, const char* end) {
+
+  if(p >= end) {
+    return nullptr;
+  }
+
+  char c = *p;
+
+  if(c == '"') {
+    return skipString(p, end);
+  }
+
+  if(c != '{' && c != '[') {
+    /* number, true, false, null - up to the next delimiter */
+    const char* begin = p;
+    while(p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+      p ++;
+    }
+    return p > begin ? p : nullptr;
+  }
+
+  /* bracket matching - only depth is tracked, contents are not validated */
+
+  v_int32 depth = 0;
+
+  while(p < end) {
+
+    if(end - p >= 8) {
+      v_uint64 word = loadWord(p);
+      if((hasByte(word, '"') | hasByte(word, '{') | hasByte(word, '}') | hasByte(word, '[') | hasByte(word, ']')) == 0) {
+        p += 8;
+        continue;
+      }
+    }
+
+    c = *p;
+    if(c == '"') {
+      p = skipString(p, end);
+      if(p == nullptr) {
+        return nullptr;
+      }
+      continue;
+    }
+    if(c == '{' || c == '[') {
+      depth ++;
+    } else if(c == '}' || c == ']') {
+      depth --;
+      if(depth == 0) {
+        return p + 1;
+      }
+    }
+    p ++;
+
+  }
+
+  return nullptr;
+
+}
+
+bool JsonScanner::unescape(const char* data, v_int32 size, std::string& result) {
+
+  result.clear();
+  result.reserve(size);
+
+  const char* p = data;
+  const char* end = data + size;
+
+  while(p < end) {
+
+    char c = *p ++;
+    if(c != '\\') {
+      result.push_back(c);
+      continue;
+    }
+
+    if(p == end) {
+      return false;
+    }
+
+    c = *p ++;
+    switch(c) {
+      case '"': result.push_back('"'); break;
+      case '\\': result.push_back('\\'); break;
+      case '/': result.push_back('/'); break;
+      case 'b': result.push_back('\b'); break;
+      case 'f': result.push_back('\f'); break;
+      case 'n': result.push_back('\n'); break;
+      case 'r': result.push_back('\r'); break;
+      case 't': result.push_back('\t'); break;
+      case 'u': {
+        v_uint32 code;
+        if(!parseHex4(p, end, code)) {
+          return false;
+        }
+        p += 4;
+        if(code >= 0xD800 && code <= 0xDBFF) {
+          v_uint32 low;
+          if(end - p < 6 || p[0] != '\\' || p[1] != 'u' || !parseHex4(p + 2, end, low) || low < 0xDC00 || low > 0xDFFF) {
+            return false;
+          }
+          p += 6;
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        }
+        appendUtf8(result, code);
+        break;
+      }
+      default:
+        return false;
+    }
+
+  }
+
+  return true;
+
+}
+
+}}
@@ -0,0 +1,75 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_JsonScanner_hpp
+#define oatpp_dtoql_JsonScanner_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Skip-ahead scanner of JSON text. <br>
+ * Values are skipped by bracket matching without being parsed. Strings and containers are scanned
+ * eight bytes at a time (SWAR) - a word is inspected byte by byte only if it holds a quote, backslash or bracket. <br>
+ * Scanner functions take a position and return the position after the scanned token, or `nullptr` if JSON is malformed.
+ */
+class JsonScanner {
+public:
+
+  static const char* skipBlank(const char* p, const char* end);
+
+  /**
+   * Skip string.
+   * @param p - position of the opening quote.
+   * @param end - end of buffer.
+   * @return - position after the closing quote or `nullptr`.
+   */
+  static const char* skipString(const char* p, const char* end);
+
+  /**
+   * Skip value of any type.
+   * @param p - position of the first char of the value.
+   * @param end - end of buffer.
+   * @return - position after the value or `nullptr`.
+   */
+  static const char* skipValue(const char* p, const char* end);
+
+  /**
+   * Decode string contents - escapes, including `\uXXXX` and surrogate pairs, are converted to UTF-8.
+   * @param data - string contents without quotes.
+   * @param size - contents size.
+   * @param result - out. Decoded string.
+   * @return - `false` if there is an invalid escape sequence.
+   */
+  static bool unescape(const char* data, v_int32 size, std::string& result);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_JsonScanner_hpp
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "MapIndex.hpp"
+
+#include "./CompiledPath.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MapIndex
+
+MapIndex::MapIndex(const AbstractFieldsMap::ObjectWrapper& map) {
+
+  v_int32 count = map->count();
+
+  m_entries.reserve(count);
+  m_hashes.reserve(count);
+
+  v_uint64 tableSize = 2;
+  while(tableSize < (v_uint64) count * 2) {
+    tableSize <<= 1;
+  }
+  m_mask = tableSize - 1;
+  m_table.resize(tableSize, -1);
+
+  auto currEntry = map->getFirstEntry();
+  while(currEntry != nullptr) {
+
+    const auto& key = currEntry->getKey();
+    v_int32 position = (v_int32) m_entries.size();
+
+    m_entries.push_back(currEntry);
+
+    if(key) {
+      v_uint64 hash = CompiledPath::hash((const char*) key->getData(), key->getSize());
+      m_hashes.push_back(hash);
+      v_uint64 slot = hash & m_mask;
+      while(m_table[slot] != -1) {
+        slot = (slot + 1) & m_mask;
+      }
+      m_table[slot] = position;
+    } else {
+      m_hashes.push_back(0);
+    }
+
+    currEntry = currEntry->getNext();
+
+  }
+
+}
+
+v_int32 MapIndex::find(const char* name, v_int32 size, v_uint64 hash) const {
+  v_uint64 slot = hash & m_mask;
+  while(m_table[slot] != -1) {
+    v_int32 position = m_table[slot];
+    if(m_hashes[position] == hash) {
+      const auto& key = m_entries[position]->getKey();
+      if(key->getSize() == size && std::memcmp(key->getData(), name, size) == 0) {
+        return position;
+      }
+    }
+    slot = (slot + 1) & m_mask;
+  }
+  return -1;
+}
+
+MapIndex::AbstractFieldsMap::Entry* MapIndex::getEntry(v_int32 position) const {
+  if(position >= 0 && position < m_entries.size()) {
+    return m_entries[position];
+  }
+  return nullptr;
+}
+
+v_int32 MapIndex::getCount() const {
+  return (v_int32) m_entries.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MapIndexCache
+
+MapIndexCache::MapIndexCache(v_int32 minMapSize, v_int32 minQueries)
+  : m_minMapSize(minMapSize)
+  , m_minQueries(minQueries)
+{}
+
+const MapIndex* MapIndexCache::getIndex(const MapIndex::AbstractFieldsMap::ObjectWrapper& map) {
+
+  v_int32 count = map->count();
+  if(count < m_minMapSize) {
+    return nullptr;
+  }
+
+  auto& record = m_records[map.get()];
+
+  if(!record.map || record.count != count) {
+    record.map = map;
+    record.count = count;
+    record.queries = 0;
+    record.index.reset();
+  }
+
+  if(!record.index) {
+    record.queries ++;
+    if(record.queries < m_minQueries) {
+      return nullptr;
+    }
+    record.index.reset(new MapIndex(map));
+  }
+
+  return record.index.get();
+
+}
+
+void MapIndexCache::clear() {
+  m_records.clear();
+}
+
+}}
@@ -0,0 +1,111 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_MapIndex_hpp
+#define oatpp_dtoql_MapIndex_hpp
+
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Transient hash index over `Fields<...>` map. <br>
+ * Gives O(1) lookup of entries by key and by position. Index is valid as long as the map is not modified.
+ */
+class MapIndex {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+  typedef oatpp::data::mapping::type::ListMap<oatpp::String, AbstractObjectWrapper> AbstractFieldsMap;
+private:
+  std::vector<AbstractFieldsMap::Entry*> m_entries;
+  std::vector<v_uint64> m_hashes;
+  std::vector<v_int32> m_table;
+  v_uint64 m_mask;
+public:
+
+  MapIndex(const AbstractFieldsMap::ObjectWrapper& map);
+
+  /**
+   * Find entry position by key.
+   * @param name - key data.
+   * @param size - key size.
+   * @param hash - key hash as returned by &l:CompiledPath::hash ();.
+   * @return - entry position or `-1`.
+   */
+  v_int32 find(const char* name, v_int32 size, v_uint64 hash) const;
+
+  AbstractFieldsMap::Entry* getEntry(v_int32 position) const;
+
+  v_int32 getCount() const;
+
+};
+
+/**
+ * Lazily builds &l:MapIndex; for large maps which are queried repeatedly. <br>
+ * Maps are held by strong reference. The cache is not thread-safe - use one per executor.
+ * Call &l:MapIndexCache::clear (); after indexed maps were modified.
+ */
+class MapIndexCache {
+private:
+
+  struct Record {
+    MapIndex::AbstractFieldsMap::ObjectWrapper map;
+    v_int32 count;
+    v_int32 queries;
+    std::unique_ptr<MapIndex> index;
+  };
+
+private:
+  v_int32 m_minMapSize;
+  v_int32 m_minQueries;
+  std::unordered_map<const void*, Record> m_records;
+public:
+
+  /**
+   * Constructor.
+   * @param minMapSize - maps smaller than this are never indexed.
+   * @param minQueries - map is indexed when queried this number of times.
+   */
+  MapIndexCache(v_int32 minMapSize = 256, v_int32 minQueries = 2);
+
+  /**
+   * Get index of the map.
+   * @param map - map.
+   * @return - &l:MapIndex; or `nullptr` if map is not worth indexing (yet).
+   */
+  const MapIndex* getIndex(const MapIndex::AbstractFieldsMap::ObjectWrapper& map);
+
+  void clear();
+
+};
+
+}}
+
+#endif // oatpp_dtoql_MapIndex_hpp
@@ -0,0 +1,186 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Mutator.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace oatpp { namespace dtoql {
+
+void Mutator::traverse(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root,
+                       const std::function<void (const Executor::Row& row)>& callback)
+{
+
+  v_int32 count = plan->getInstructionsCount();
+  if(count == 0) {
+    throw std::runtime_error("[oatpp::dtoql::Mutator::traverse()]: Error. Path selects the root itself.");
+  }
+  if(plan->getInstructions()[count - 1].opcode == CompiledPath::SELECT_DESCENDANTS) {
+    throw std::runtime_error("[oatpp::dtoql::Mutator::traverse()]: Error. Path ends with recursive descent.");
+  }
+
+  Executor executor;
+  executor.start(plan, root);
+  while(executor.next()) {
+    callback(executor.getRow());
+  }
+
+}
+
+v_int64 Mutator::set(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const AbstractObjectWrapper& value) {
+  return apply(plan, root, [&value](const Executor::Row& row) {
+    return value;
+  });
+}
+
+v_int64 Mutator::apply(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const Functor& functor) {
+
+  /* parents are held until all writes are done - every slot stays valid even if a write releases a subtree */
+
+  std::vector<Write> writes;
+  traverse(plan, root, [&writes, &functor](const Executor::Row& row) {
+    v_int32 leaf = row.getSize() - 1;
+    writes.push_back(Write{*row[leaf - 1].value, const_cast<AbstractObjectWrapper*>(row[leaf].value), functor(row)});
+  });
+
+  for(auto& write : writes) {
+    *write.slot = write.value;
+  }
+
+  return (v_int64) writes.size();
+
+}
+
+v_int64 Mutator::removeInList(AbstractList* list, std::vector<v_int64>& positions) {
+
+  std::sort(positions.begin(), positions.end());
+  positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+  /* rotate the list through popFront / pushBack once, dropping removed positions */
+
+  v_int32 count = list->count();
+  size_t k = 0;
+  for(v_int32 i = 0; i < count; i ++) {
+    auto data = list->popFront();
+    if(k < positions.size() && positions[k] == i) {
+      k ++;
+    } else {
+      list->pushBack(data);
+    }
+  }
+
+  return (v_int64) positions.size();
+
+}
+
+v_int64 Mutator::removeInMap(AbstractFieldsMap* map, std::vector<v_int64>& positions) {
+
+  std::sort(positions.begin(), positions.end());
+  positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+  if(positions.empty()) {
+    return 0;
+  }
+
+  if((v_int64) positions.size() == (v_int64) map->count()) {
+    map->clear();
+    return (v_int64) positions.size();
+  }
+
+  /* ListMap can't unlink an entry or append without a key lookup -
+   * re-putting the kept entries costs O(n^2) key comparisons for a map of n entries */
+
+  std::vector<std::pair<oatpp::String, AbstractObjectWrapper>> kept;
+  kept.reserve((size_t) map->count());
+
+  auto entry = map->getFirstEntry();
+  v_int64 position = 0;
+  size_t k = 0;
+  while(entry != nullptr) {
+    if(k < positions.size() && positions[k] == position) {
+      k ++;
+    } else {
+      kept.push_back({entry->getKey(), entry->getValue()});
+    }
+    position ++;
+    entry = entry->getNext();
+  }
+
+  map->clear();
+  for(const auto& pair : kept) {
+    map->put(pair.first, pair.second);
+  }
+
+  return (v_int64) positions.size();
+
+}
+
+v_int64 Mutator::remove(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  std::vector<Removal> removals;
+  std::unordered_map<const void*, size_t> parents;
+
+  traverse(plan, root, [&removals, &parents](const Executor::Row& row) {
+    v_int32 leaf = row.getSize() - 1;
+    const auto& parent = *row[leaf - 1].value;
+    auto it = parents.find(parent.get());
+    if(it == parents.end()) {
+      it = parents.insert({parent.get(), removals.size()}).first;
+      removals.push_back(Removal{parent, {}, {}});
+    }
+    removals[it->second].positions.push_back(row[leaf].index);
+    removals[it->second].slots.push_back(const_cast<AbstractObjectWrapper*>(row[leaf].value));
+  });
+
+  v_int64 count = 0;
+
+  for(auto& removal : removals) {
+
+    auto classId = removal.parent.valueType->classId.id;
+
+    if(classId == type::__class::AbstractList::CLASS_ID.id) {
+      count += removeInList(static_cast<AbstractList*>(removal.parent.get()), removal.positions);
+    } else if(classId == type::__class::AbstractListMap::CLASS_ID.id) {
+      count += removeInMap(static_cast<AbstractFieldsMap*>(removal.parent.get()), removal.positions);
+    } else {
+      std::sort(removal.slots.begin(), removal.slots.end());
+      removal.slots.erase(std::unique(removal.slots.begin(), removal.slots.end()), removal.slots.end());
+      for(auto slot : removal.slots) {
+        *slot = nullptr;
+      }
+      count += (v_int64) removal.slots.size();
+    }
+
+  }
+
+  return count;
+
+}
+
+}}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Mutator_hpp
+#define oatpp_dtoql_Mutator_hpp
+
+#include "./Executor.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * In-place updates of the values a path matches. <br>
+ * The path is traversed once. Each matched field is written through its slot in the parent object, list or map -
+ * parents are not looked up again. Writes are applied after the traversal, so the traversal never sees a modified tree. <br>
+ * Removals are grouped by parent - each list or map is rebuilt once. Object properties can't be removed and are set to `null`. <br>
+ * The last component of the path must not be a recursive descent - its fields have no parent in the row.
+ */
+class Mutator {
+public:
+  typedef Executor::AbstractObjectWrapper AbstractObjectWrapper;
+  typedef Executor::AbstractList AbstractList;
+  typedef Executor::AbstractFieldsMap AbstractFieldsMap;
+public:
+
+  /**
+   * Compute new value of the matched field. Current value is `*row[row.getSize() - 1].value`.
+   */
+  typedef std::function<AbstractObjectWrapper (const Executor::Row& row)> Functor;
+
+private:
+
+  struct Write {
+    AbstractObjectWrapper parent;
+    AbstractObjectWrapper* slot;
+    AbstractObjectWrapper value;
+  };
+
+  struct Removal {
+    AbstractObjectWrapper parent;
+    std::vector<v_int64> positions;
+    std::vector<AbstractObjectWrapper*> slots;
+  };
+
+private:
+  static void traverse(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root,
+                       const std::function<void (const Executor::Row& row)>& callback);
+  static v_int64 removeInList(AbstractList* list, std::vector<v_int64>& positions);
+  static v_int64 removeInMap(AbstractFieldsMap* map, std::vector<v_int64>& positions);
+public:
+
+  /**
+   * Set value of each matched field.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param value - new value.
+   * @return - number of fields written.
+   */
+  static v_int64 set(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const AbstractObjectWrapper& value);
+
+  /**
+   * Replace value of each matched field with the result of functor.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @param functor - &l:Mutator::Functor;. Called during the traversal.
+   * @return - number of fields written.
+   */
+  static v_int64 apply(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root, const Functor& functor);
+
+  /**
+   * Remove each matched list element and map entry. Matched object properties are set to `null`. <br>
+   * A list is rebuilt in linear time. A map which keeps some of its entries is rebuilt with `put`,
+   * which looks each key up - quadratic in the number of entries kept. Prefer lists for large collections.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object.
+   * @return - number of fields removed.
+   */
+  static v_int64 remove(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Mutator_hpp
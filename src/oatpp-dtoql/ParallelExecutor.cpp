@@ -0,0 +1,286 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ParallelExecutor.hpp"
+
+namespace oatpp { namespace dtoql {
+
+ParallelExecutor::Segment* ParallelExecutor::Segment::addPart() {
+  parts.emplace_back(new Segment());
+  return parts.back().get();
+}
+
+ParallelExecutor::ParallelExecutor(v_int32 threadsCount, v_int32 granularity)
+  : m_granularity(granularity > 0 ? granularity : 1)
+  , m_queued(0)
+  , m_pending(0)
+  , m_tasksCount(0)
+  , m_error(nullptr)
+  , m_stop(false)
+{
+
+  if(threadsCount < 1) {
+    threadsCount = 1;
+  }
+
+  for(v_int32 i = 0; i < threadsCount; i ++) {
+    m_workers.emplace_back(new Worker());
+  }
+
+  for(v_int32 i = 0; i < threadsCount; i ++) {
+    m_workers[i]->thread = std::thread(&ParallelExecutor::run, this, i);
+  }
+
+}
+
+ParallelExecutor::~ParallelExecutor() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_tasksCondition.notify_all();
+
+  for(auto& worker : m_workers) {
+    worker->thread.join();
+  }
+
+}
+
+void ParallelExecutor::collect(Segment& segment, ResultTable& result) {
+  for(auto& row : segment.rows) {
+    result.push_back(std::move(row));
+  }
+  for(auto& part : segment.parts) {
+    collect(*part, result);
+  }
+}
+
+void ParallelExecutor::push(Worker& worker, Task&& task) {
+
+  m_pending ++;
+  m_tasksCount ++;
+
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued ++;
+  }
+  m_tasksCondition.notify_one();
+
+}
+
+bool ParallelExecutor::pop(Worker& worker, Task& task) {
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if(worker.tasks.empty()) {
+    return false;
+  }
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  m_queued --;
+  return true;
+}
+
+bool ParallelExecutor::steal(v_int32 thief, Task& task) {
+
+  v_int32 count = (v_int32) m_workers.size();
+
+  for(v_int32 i = 1; i < count; i ++) {
+    Worker& victim = *m_workers[(thief + i) % count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if(!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      m_queued --;
+      return true;
+    }
+  }
+
+  return false;
+
+}
+
+void ParallelExecutor::process(Worker& worker, Task&& task) {
+
+  if(task.fields.size() > m_granularity) {
+
+    /* oldest (largest) parts are stolen first - the owner keeps splitting the left half */
+
+    v_int32 middle = (v_int32) task.fields.size() / 2;
+
+    Task right;
+    right.path = task.path;
+    right.fields.assign(task.fields.begin() + middle, task.fields.end());
+
+    Segment* left = task.segment->addPart();
+    right.segment = task.segment->addPart();
+    push(worker, std::move(right));
+
+    task.fields.resize(middle);
+    task.segment = left;
+    process(worker, std::move(task));
+    return;
+
+  }
+
+  if(worker.selections.size() < m_plan->getInstructionsCount()) {
+    worker.selections.resize(m_plan->getInstructionsCount());
+  }
+
+  Segment* out = nullptr;
+  descend(worker, task.path, task.fields.data(), (v_int32) task.fields.size(), task.segment, out);
+
+}
+
+void ParallelExecutor::descend(Worker& worker, std::vector<Executor::FieldView>& path, const Executor::FieldView* fields, v_int32 count,
+                               Segment* segment, Segment*& out)
+{
+
+  v_int32 level = (v_int32) path.size();
+  v_int32 leafLevel = m_plan->getInstructionsCount();
+
+  for(v_int32 i = 0; i < count; i ++) {
+
+    path.push_back(fields[i]);
+
+    if(level < leafLevel) {
+
+      /* selection buffer of each level is reused - fields of the level above are in the buffer of that level */
+      auto& selection = worker.selections[level];
+      worker.executor.select(m_plan, level, *fields[i].value, selection);
+
+      if(selection.size() > m_granularity) {
+        Task child;
+        child.path = path;
+        child.fields = selection;
+        child.segment = segment->addPart();
+        out = nullptr;
+        process(worker, std::move(child));
+      } else {
+        descend(worker, path, selection.data(), (v_int32) selection.size(), segment, out);
+      }
+
+    } else {
+
+      if(out == nullptr) {
+        out = segment->addPart();
+      }
+      std::vector<Traverser::Field> row;
+      row.reserve(path.size());
+      for(const auto& view : path) {
+        row.push_back(Traverser::Field(view.getName(), view.index, *view.value));
+      }
+      out->rows.push_back(std::move(row));
+
+    }
+
+    path.pop_back();
+
+  }
+
+}
+
+void ParallelExecutor::run(v_int32 workerIndex) {
+
+  Worker& worker = *m_workers[workerIndex];
+
+  while(true) {
+
+    Task task;
+
+    if(pop(worker, task) || steal(workerIndex, task)) {
+
+      try {
+        process(worker, std::move(task));
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_error) {
+          m_error = std::current_exception();
+        }
+      }
+
+      if(-- m_pending == 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_doneCondition.notify_all();
+      }
+
+      continue;
+
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasksCondition.wait(lock, [this]{ return m_stop || m_queued > 0; });
+    if(m_stop) {
+      return;
+    }
+
+  }
+
+}
+
+ParallelExecutor::ResultTable ParallelExecutor::execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root) {
+
+  std::lock_guard<std::mutex> guard(m_executeMutex);
+
+  m_plan = plan;
+  m_error = nullptr;
+  m_tasksCount = 0;
+
+  AbstractObjectWrapper value = root;
+  Segment segment;
+
+  Task task;
+  task.fields.push_back(Executor::FieldView{nullptr, 0, nullptr, 0, &value});
+  task.segment = &segment;
+  push(*m_workers[0], std::move(task));
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]{ return m_pending == 0; });
+  }
+
+  if(m_error) {
+    std::rethrow_exception(m_error);
+  }
+
+  ResultTable result;
+  collect(segment, result);
+  return result;
+
+}
+
+v_int32 ParallelExecutor::getThreadsCount() const {
+  return (v_int32) m_workers.size();
+}
+
+v_int32 ParallelExecutor::getTasksCount() const {
+  return m_tasksCount;
+}
+
+}}
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_ParallelExecutor_hpp
+#define oatpp_dtoql_ParallelExecutor_hpp
+
+#include "./Traverser.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Executes &l:CompiledPath; on a pool of work-stealing threads. <br>
+ * The plan is evaluated level by level. Selections larger than the granularity, at any level, are split in halves -
+ * one half is pushed to the worker's deque where idle workers may steal it, the other half is processed in place. Each part writes rows to its own segment
+ * and segments are merged in the order of parts, so the result is identical to &l:Traverser::getResultTable ();. <br>
+ * Executor is reusable, queries are executed one at a time.
+ */
+class ParallelExecutor {
+public:
+  typedef Executor::AbstractObjectWrapper AbstractObjectWrapper;
+  typedef std::vector<std::vector<Traverser::Field>> ResultTable;
+private:
+
+  struct Segment {
+    ResultTable rows;
+    std::vector<std::unique_ptr<Segment>> parts;
+    Segment* addPart();
+  };
+
+  struct Task {
+    std::vector<Executor::FieldView> path;
+    std::vector<Executor::FieldView> fields;
+    Segment* segment;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    Executor executor;
+    std::vector<std::vector<Executor::FieldView>> selections;
+    std::thread thread;
+  };
+
+private:
+  static void collect(Segment& segment, ResultTable& result);
+private:
+  void push(Worker& worker, Task&& task);
+  bool pop(Worker& worker, Task& task);
+  bool steal(v_int32 thief, Task& task);
+  void process(Worker& worker, Task&& task);
+  void descend(Worker& worker, std::vector<Executor::FieldView>& path, const Executor::FieldView* fields, v_int32 count,
+               Segment* segment, Segment*& out);
+  void run(v_int32 workerIndex);
+private:
+  v_int32 m_granularity;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::shared_ptr<CompiledPath> m_plan;
+private:
+  std::mutex m_executeMutex;
+  std::mutex m_mutex;
+  std::condition_variable m_tasksCondition;
+  std::condition_variable m_doneCondition;
+  std::atomic<v_int32> m_queued;
+  std::atomic<v_int32> m_pending;
+  std::atomic<v_int32> m_tasksCount;
+  std::exception_ptr m_error;
+  bool m_stop;
+public:
+
+  /**
+   * Constructor.
+   * @param threadsCount - number of worker threads.
+   * @param granularity - selections of this size or smaller are not split.
+   */
+  ParallelExecutor(v_int32 threadsCount = (v_int32) std::thread::hardware_concurrency(), v_int32 granularity = 64);
+
+  ParallelExecutor(const ParallelExecutor& other) = delete;
+  ParallelExecutor& operator=(const ParallelExecutor& other) = delete;
+
+  ~ParallelExecutor();
+
+  /**
+   * Execute query.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object. Must not be modified during the query.
+   * @return - rows in the same order as produced by &l:Executor;.
+   */
+  ResultTable execute(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& root);
+
+  v_int32 getThreadsCount() const;
+
+  /**
+   * Number of tasks of the last query. `1` if no selection was split.
+   * @return
+   */
+  v_int32 getTasksCount() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_ParallelExecutor_hpp
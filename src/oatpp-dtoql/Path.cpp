@@ -26,6 +26,9 @@
 
 #include "oatpp/core/data/stream/BufferStream.hpp"
 
+#include <cstdio>
+#include <cstring>
+
 namespace oatpp { namespace dtoql {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,22 +43,107 @@ Path::ComponentType Path::Component::getType() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// FieldCollection
+// Slice
+
+Path::Slice::Slice(bool hasStart, v_int64 start, bool hasEnd, v_int64 end, v_int64 step)
+  : m_start(hasStart ? start : 0)
+  , m_end(hasEnd ? end : 0)
+  , m_step(step)
+  , m_hasStart(hasStart)
+  , m_hasEnd(hasEnd)
+{}
+
+Path::Slice Path::Slice::all(v_int64 step) {
+  return Slice(false, 0, false, 0, step);
+}
+
+Path::Slice Path::Slice::from(v_int64 start, v_int64 step) {
+  return Slice(true, start, false, 0, step);
+}
+
+Path::Slice Path::Slice::to(v_int64 end, v_int64 step) {
+  return Slice(false, 0, true, end, step);
+}
+
+v_int64 Path::Slice::getStart() const {
+  return m_start;
+}
+
+v_int64 Path::Slice::getEnd() const {
+  return m_end;
+}
+
+v_int64 Path::Slice::getStep() const {
+  return m_step;
+}
+
+bool Path::Slice::hasStart() const {
+  return m_hasStart;
+}
+
+bool Path::Slice::hasEnd() const {
+  return m_hasEnd;
+}
+
+v_int64 Path::Slice::resolve(v_int64 count, v_int64& first) const {
+
+  first = 0;
 
+  if(m_step == 0 || count <= 0) {
+    return 0;
+  }
+
+  v_int64 start;
+  v_int64 end;
+
+  if(m_step > 0) {
+    start = m_hasStart ? (m_start < 0 ? m_start + count : m_start) : 0;
+    end = m_hasEnd ? (m_end < 0 ? m_end + count : m_end) : count;
+    if(start < 0) start = 0;
+    if(end > count) end = count;
+    if(start >= end) {
+      return 0;
+    }
+    first = start;
+    return (end - start + m_step - 1) / m_step;
+  }
+
+  start = m_hasStart ? (m_start < 0 ? m_start + count : m_start) : count - 1;
+  end = m_hasEnd ? (m_end < 0 ? m_end + count : m_end) : -1;
+  if(start > count - 1) start = count - 1;
+  if(end < -1) end = -1;
+  if(start <= end) {
+    return 0;
+  }
+  first = start;
+  return (start - end - m_step - 1) / (-m_step);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FieldReference
 
 Path::FieldReference::FieldReference(const oatpp::String& name)
   : m_name(name)
   , m_index(-1)
+  , m_slice(Slice::all())
   , m_type(NAME)
 {}
 
 Path::FieldReference::FieldReference(v_int64 index)
   : m_name(nullptr)
   , m_index(index)
+  , m_slice(Slice::all())
   , m_type(INDEX)
 {}
 
+Path::FieldReference::FieldReference(const Slice& slice)
+  : m_name(nullptr)
+  , m_index(-1)
+  , m_slice(slice)
+  , m_type(SLICE)
+{}
+
 oatpp::String Path::FieldReference::getName() const {
   return m_name;
 }
@@ -64,10 +152,15 @@ v_int64 Path::FieldReference::getIndex() const {
   return m_index;
 }
 
+const Path::Slice& Path::FieldReference::getSlice() const {
+  return m_slice;
+}
+
 Path::FieldReference::Type Path::FieldReference::getType() const {
   return m_type;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // FieldCollection
 
 Path::FieldCollection::FieldCollection(const std::vector<FieldReference>& fields)
@@ -80,7 +173,7 @@ const std::vector<Path::FieldReference>& Path::FieldCollection::getFields() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// FieldCollection
+// Variable
 
 Path::Variable::Variable(const oatpp::String& name)
   : Component(ComponentType::VARIABLE)
@@ -91,9 +184,167 @@ oatpp::String Path::Variable::getName() {
   return m_name;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RecursiveDescent
+
+Path::RecursiveDescent::RecursiveDescent(v_int32 maxDepth)
+  : Component(ComponentType::RECURSIVE_DESCENT)
+  , m_maxDepth(maxDepth < 0 ? -1 : maxDepth)
+{}
+
+v_int32 Path::RecursiveDescent::getMaxDepth() {
+  return m_maxDepth;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Literal
+
+Path::Literal::Literal()
+  : m_type(NULL_VALUE)
+  , m_boolean(false)
+  , m_integer(0)
+  , m_float(0)
+  , m_string(nullptr)
+{}
+
+Path::Literal::Literal(bool value)
+  : Literal()
+{
+  m_type = BOOLEAN;
+  m_boolean = value;
+}
+
+Path::Literal::Literal(v_int64 value)
+  : Literal()
+{
+  m_type = INTEGER;
+  m_integer = value;
+}
+
+Path::Literal::Literal(v_float64 value)
+  : Literal()
+{
+  m_type = FLOAT;
+  m_float = value;
+}
+
+Path::Literal::Literal(const oatpp::String& value)
+  : Literal()
+{
+  if(value) {
+    m_type = STRING;
+    m_string = value;
+  }
+}
+
+Path::Literal::Type Path::Literal::getType() const {
+  return m_type;
+}
+
+bool Path::Literal::getBoolean() const {
+  return m_boolean;
+}
+
+v_int64 Path::Literal::getInteger() const {
+  return m_integer;
+}
+
+v_float64 Path::Literal::getFloat() const {
+  return m_float;
+}
+
+oatpp::String Path::Literal::getString() const {
+  return m_string;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Expression
+
+Path::Expression::Expression(Type type, Operator op, const std::vector<oatpp::String>& operand, const Literal& literal,
+                             const std::vector<std::shared_ptr<Expression>>& children)
+  : m_type(type)
+  , m_operator(op)
+  , m_operand(operand)
+  , m_literal(literal)
+  , m_children(children)
+{}
+
+std::shared_ptr<Path::Expression> Path::Expression::compare(const std::vector<oatpp::String>& operand, Operator op, const Literal& literal) {
+  return std::make_shared<Expression>(COMPARISON, op, operand, literal, std::vector<std::shared_ptr<Expression>>());
+}
+
+std::shared_ptr<Path::Expression> Path::Expression::exists(const std::vector<oatpp::String>& operand) {
+  return std::make_shared<Expression>(EXISTS, EQ, operand, Literal(), std::vector<std::shared_ptr<Expression>>());
+}
+
+std::shared_ptr<Path::Expression> Path::Expression::allOf(const std::vector<std::shared_ptr<Expression>>& expressions) {
+  return std::make_shared<Expression>(AND, EQ, std::vector<oatpp::String>(), Literal(), expressions);
+}
+
+std::shared_ptr<Path::Expression> Path::Expression::anyOf(const std::vector<std::shared_ptr<Expression>>& expressions) {
+  return std::make_shared<Expression>(OR, EQ, std::vector<oatpp::String>(), Literal(), expressions);
+}
+
+std::shared_ptr<Path::Expression> Path::Expression::negate(const std::shared_ptr<Expression>& expression) {
+  return std::make_shared<Expression>(NOT, EQ, std::vector<oatpp::String>(), Literal(), std::vector<std::shared_ptr<Expression>>({expression}));
+}
+
+Path::Expression::Type Path::Expression::getType() const {
+  return m_type;
+}
+
+Path::Expression::Operator Path::Expression::getOperator() const {
+  return m_operator;
+}
+
+const std::vector<oatpp::String>& Path::Expression::getOperand() const {
+  return m_operand;
+}
+
+const Path::Literal& Path::Expression::getLiteral() const {
+  return m_literal;
+}
+
+const std::vector<std::shared_ptr<Path::Expression>>& Path::Expression::getChildren() const {
+  return m_children;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Filter
+
+Path::Filter::Filter(const std::shared_ptr<Expression>& expression)
+  : Component(ComponentType::FILTER)
+  , m_expression(expression)
+{}
+
+std::shared_ptr<Path::Expression> Path::Filter::getExpression() {
+  return m_expression;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Path
 
+void Path::writeName(oatpp::data::stream::ConsistentOutputStream& stream, const oatpp::String& name) {
+
+  stream << "'";
+
+  p_char8 data = name->getData();
+  v_int32 size = name->getSize();
+  v_int32 start = 0;
+
+  for(v_int32 i = 0; i < size; i ++) {
+    if(data[i] == '\'' || data[i] == '\\') {
+      stream.write(&data[start], i - start);
+      stream << "\\";
+      start = i;
+    }
+  }
+
+  stream.write(&data[start], size - start);
+  stream << "'";
+
+}
+
 Path::Path(const std::vector<std::shared_ptr<Component>>& components)
   : m_components(components)
 {}
@@ -102,13 +353,133 @@ const std::vector<std::shared_ptr<Path::Component>>& Path::getComponents() {
   return m_components;
 }
 
+void Path::writeSlice(oatpp::data::stream::ConsistentOutputStream& stream, const Slice& slice) {
+  if(slice.hasStart()) {
+    stream << slice.getStart();
+  }
+  stream << ":";
+  if(slice.hasEnd()) {
+    stream << slice.getEnd();
+  }
+  if(slice.getStep() != 1) {
+    stream << ":" << slice.getStep();
+  }
+}
+
+void Path::writeOperand(oatpp::data::stream::ConsistentOutputStream& stream, const std::vector<oatpp::String>& operand) {
+
+  stream << "@";
+
+  for(const auto& name : operand) {
+
+    p_char8 data = name->getData();
+    v_int32 size = name->getSize();
+
+    bool isIdentifier = size > 0 && !(data[0] >= '0' && data[0] <= '9');
+    for(v_int32 i = 0; i < size && isIdentifier; i ++) {
+      v_char8 a = data[i];
+      isIdentifier = (a >= 'a' && a <= 'z') || (a >= 'A' && a <= 'Z') || (a >= '0' && a <= '9') || a == '_';
+    }
+
+    if(isIdentifier) {
+      stream << "." << name;
+    } else {
+      stream << "[";
+      writeName(stream, name);
+      stream << "]";
+    }
+
+  }
+
+}
+
+void Path::writeLiteral(oatpp::data::stream::ConsistentOutputStream& stream, const Literal& literal) {
+
+  switch(literal.getType()) {
+
+    case Literal::NULL_VALUE: stream << "null"; break;
+    case Literal::BOOLEAN: stream << (literal.getBoolean() ? "true" : "false"); break;
+    case Literal::INTEGER: stream << literal.getInteger(); break;
+    case Literal::STRING: writeName(stream, literal.getString()); break;
+
+    case Literal::FLOAT: {
+      /* keep the decimal point so that the literal is parsed back as float */
+      v_char8 buffer[32];
+      v_int32 size = std::snprintf((char*) buffer, sizeof(buffer) - 2, "%.17g", literal.getFloat());
+      if(size < 0) {
+        size = 0;
+      } else if(size > (v_int32) sizeof(buffer) - 3) {
+        size = (v_int32) sizeof(buffer) - 3; // never write the terminating null
+      }
+      if(std::strpbrk((char*) buffer, ".enEN") == nullptr) {
+        buffer[size ++] = '.';
+        buffer[size ++] = '0';
+      }
+      stream.write(buffer, size);
+      break;
+    }
+
+  }
+
+}
+
+void Path::writeExpression(oatpp::data::stream::ConsistentOutputStream& stream, const Expression& expression, v_int32 parentPrecedence) {
+
+  static const char* const operators[] = {" == ", " != ", " < ", " <= ", " > ", " >= ", " ^= "};
+
+  switch(expression.getType()) {
+
+    case Expression::COMPARISON:
+      writeOperand(stream, expression.getOperand());
+      stream << operators[expression.getOperator()];
+      writeLiteral(stream, expression.getLiteral());
+      break;
+
+    case Expression::EXISTS:
+      writeOperand(stream, expression.getOperand());
+      break;
+
+    case Expression::NOT:
+      stream << "!(";
+      writeExpression(stream, *expression.getChildren()[0], 0);
+      stream << ")";
+      break;
+
+    case Expression::AND:
+    case Expression::OR: {
+      v_int32 precedence = expression.getType() == Expression::AND ? 2 : 1;
+      const auto& children = expression.getChildren();
+      if(precedence < parentPrecedence) stream << "(";
+      for(v_int32 i = 0; i < children.size(); i ++) {
+        if(i > 0) {
+          stream << (precedence == 2 ? " && " : " || ");
+        }
+        writeExpression(stream, *children[i], precedence);
+      }
+      if(precedence < parentPrecedence) stream << ")";
+      break;
+    }
+
+  }
+
+}
+
 oatpp::String Path::toString() {
 
   oatpp::data::stream::BufferOutputStream stream;
+  bool afterSelector = false;
 
   for(auto& component : m_components) {
 
-    switch(component->getType()) {
+    auto type = component->getType();
+
+    /* parser reads `..` before `.` - keep field selector apart from the next dot */
+    if(afterSelector && (type == FIELD_SELECTOR || type == RECURSIVE_DESCENT)) {
+      stream << " ";
+    }
+    afterSelector = (type == FIELD_SELECTOR);
+
+    switch(type) {
 
       case RE_ROOT: stream << "/"; break;
       case FIELD_SELECTOR: stream << "."; break;
@@ -121,8 +492,9 @@ oatpp::String Path::toString() {
           const auto& field = fields[i];
 
           switch(field.getType()) {
-            case FieldReference::Type::NAME: stream << "'" << field.getName() << "'"; break;
+            case FieldReference::Type::NAME: writeName(stream, field.getName()); break;
             case FieldReference::Type::INDEX: stream << field.getIndex(); break;
+            case FieldReference::Type::SLICE: writeSlice(stream, field.getSlice()); break;
           }
 
           if(i < fields.size() - 1) {
@@ -134,6 +506,13 @@ oatpp::String Path::toString() {
         break;
       }
 
+      case FILTER: {
+        stream << "[?(";
+        writeExpression(stream, *std::static_pointer_cast<Filter>(component)->getExpression(), 0);
+        stream << ")]";
+        break;
+      }
+
       case VARIABLE: {
         auto name = std::static_pointer_cast<Variable>(component)->getName();
         if (name) {
@@ -144,6 +523,15 @@ oatpp::String Path::toString() {
         break;
       }
 
+      case RECURSIVE_DESCENT: {
+        stream << "..";
+        v_int32 maxDepth = std::static_pointer_cast<RecursiveDescent>(component)->getMaxDepth();
+        if(maxDepth >= 0) {
+          stream << "{" << maxDepth << "}";
+        }
+        break;
+      }
+
     }
 
   }
@@ -175,6 +563,16 @@ Path::Builder& Path::Builder::variable(const oatpp::String& name) {
   return *this;
 }
 
+Path::Builder& Path::Builder::filter(const std::shared_ptr<Expression>& expression) {
+  m_components.push_back(std::make_shared<Filter>(expression));
+  return *this;
+}
+
+Path::Builder& Path::Builder::descendants(v_int32 maxDepth) {
+  m_components.push_back(std::make_shared<RecursiveDescent>(maxDepth));
+  return *this;
+}
+
 Path Path::Builder::build() {
   return Path(m_components);
 }
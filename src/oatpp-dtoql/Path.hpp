@@ -25,6 +25,7 @@
 #ifndef oatpp_dtoql_Path_hpp
 #define oatpp_dtoql_Path_hpp
 
+#include "oatpp/core/data/stream/Stream.hpp"
 #include "oatpp/core/Types.hpp"
 #include <vector>
 
@@ -37,7 +38,9 @@ public:
     RE_ROOT = 0,
     FIELD_SELECTOR = 1,
     FIELD_COLLECTION = 2,
-    VARIABLE = 3
+    VARIABLE = 3,
+    FILTER = 4,
+    RECURSIVE_DESCENT = 5
   };
 
   class Component {
@@ -63,24 +66,63 @@ public:
     FieldSelector() : Component(ComponentType::FIELD_SELECTOR) {}
   };
 
+  /**
+   * Python-like slice of positions `[start:end:step]`. Negative start/end count from the end of container.
+   */
+  class Slice {
+  private:
+    v_int64 m_start;
+    v_int64 m_end;
+    v_int64 m_step;
+    bool m_hasStart;
+    bool m_hasEnd;
+  public:
+
+    Slice(bool hasStart, v_int64 start, bool hasEnd, v_int64 end, v_int64 step = 1);
+    Slice(v_int64 start, v_int64 end, v_int64 step = 1) : Slice(true, start, true, end, step) {}
+
+    static Slice all(v_int64 step = 1);
+    static Slice from(v_int64 start, v_int64 step = 1);
+    static Slice to(v_int64 end, v_int64 step = 1);
+
+    v_int64 getStart() const;
+    v_int64 getEnd() const;
+    v_int64 getStep() const;
+    bool hasStart() const;
+    bool hasEnd() const;
+
+    /**
+     * Resolve slice against container of given size.
+     * @param count - number of elements in container.
+     * @param first - out. First selected position.
+     * @return - number of selected positions. Positions are `first + i * step`.
+     */
+    v_int64 resolve(v_int64 count, v_int64& first) const;
+
+  };
+
   class FieldReference {
   public:
     enum Type : v_int32 {
       NAME = 0,
-      INDEX = 1
+      INDEX = 1,
+      SLICE = 2
     };
   private:
     oatpp::String m_name;
     v_int64 m_index;
+    Slice m_slice;
     Type m_type;
   public:
 
     FieldReference(const oatpp::String& name);
     FieldReference(const char* name) : FieldReference(oatpp::String(name)) {};
     FieldReference(v_int64 index);
+    FieldReference(const Slice& slice);
 
     oatpp::String getName() const;
     v_int64 getIndex() const;
+    const Slice& getSlice() const;
     Type getType() const;
 
   };
@@ -105,6 +147,131 @@ public:
 
   };
 
+  /**
+   * Constant operand of &l:Path::Expression;.
+   */
+  class Literal {
+  public:
+    enum Type : v_int32 {
+      NULL_VALUE = 0,
+      BOOLEAN = 1,
+      INTEGER = 2,
+      FLOAT = 3,
+      STRING = 4
+    };
+  private:
+    Type m_type;
+    bool m_boolean;
+    v_int64 m_integer;
+    v_float64 m_float;
+    oatpp::String m_string;
+  public:
+
+    Literal();
+    Literal(std::nullptr_t) : Literal() {}
+    Literal(bool value);
+    Literal(v_int32 value) : Literal((v_int64) value) {}
+    Literal(v_int64 value);
+    Literal(v_float64 value);
+    Literal(const oatpp::String& value);
+    Literal(const char* value) : Literal(oatpp::String(value)) {}
+
+    Type getType() const;
+    bool getBoolean() const;
+    v_int64 getInteger() const;
+    v_float64 getFloat() const;
+    oatpp::String getString() const;
+
+  };
+
+  /**
+   * Boolean expression evaluated against a candidate field. <br>
+   * Operand is a chain of names relative to the candidate (`@.a.b`), empty chain is the candidate itself (`@`).
+   */
+  class Expression {
+  public:
+
+    enum Type : v_int32 {
+      COMPARISON = 0,
+      EXISTS = 1,
+      AND = 2,
+      OR = 3,
+      NOT = 4
+    };
+
+    enum Operator : v_int32 {
+      EQ = 0,
+      NE = 1,
+      LT = 2,
+      LE = 3,
+      GT = 4,
+      GE = 5,
+      STARTS_WITH = 6
+    };
+
+  private:
+    Type m_type;
+    Operator m_operator;
+    std::vector<oatpp::String> m_operand;
+    Literal m_literal;
+    std::vector<std::shared_ptr<Expression>> m_children;
+  public:
+
+    Expression(Type type, Operator op, const std::vector<oatpp::String>& operand, const Literal& literal,
+               const std::vector<std::shared_ptr<Expression>>& children);
+
+    static std::shared_ptr<Expression> compare(const std::vector<oatpp::String>& operand, Operator op, const Literal& literal);
+    static std::shared_ptr<Expression> exists(const std::vector<oatpp::String>& operand);
+    static std::shared_ptr<Expression> allOf(const std::vector<std::shared_ptr<Expression>>& expressions);
+    static std::shared_ptr<Expression> anyOf(const std::vector<std::shared_ptr<Expression>>& expressions);
+    static std::shared_ptr<Expression> negate(const std::shared_ptr<Expression>& expression);
+
+    Type getType() const;
+    Operator getOperator() const;
+    const std::vector<oatpp::String>& getOperand() const;
+    const Literal& getLiteral() const;
+    const std::vector<std::shared_ptr<Expression>>& getChildren() const;
+
+  };
+
+  /**
+   * Select all fields matching the expression.
+   */
+  class Filter : public Component {
+  private:
+    std::shared_ptr<Expression> m_expression;
+  public:
+
+    Filter(const std::shared_ptr<Expression>& expression);
+    std::shared_ptr<Expression> getExpression();
+
+  };
+
+  /**
+   * Select the value itself and all its descendants, depth-first, so that the next component matches at any depth. <br>
+   * Each object, list or map is visited once - shared and cyclic references are not followed twice.
+   * The value itself is selected with no name and index `-1`.
+   */
+  class RecursiveDescent : public Component {
+  private:
+    v_int32 m_maxDepth;
+  public:
+
+    /**
+     * Constructor.
+     * @param maxDepth - max depth of descendants. `0` - the value itself. Negative - no limit.
+     */
+    RecursiveDescent(v_int32 maxDepth);
+    v_int32 getMaxDepth();
+
+  };
+
+private:
+  static void writeName(oatpp::data::stream::ConsistentOutputStream& stream, const oatpp::String& name);
+  static void writeOperand(oatpp::data::stream::ConsistentOutputStream& stream, const std::vector<oatpp::String>& operand);
+  static void writeLiteral(oatpp::data::stream::ConsistentOutputStream& stream, const Literal& literal);
+  static void writeExpression(oatpp::data::stream::ConsistentOutputStream& stream, const Expression& expression, v_int32 parentPrecedence);
+  static void writeSlice(oatpp::data::stream::ConsistentOutputStream& stream, const Slice& slice);
 private:
   std::vector<std::shared_ptr<Component>> m_components;
 public:
@@ -130,6 +297,10 @@ public:
 
     Builder& variable(const oatpp::String& name);
 
+    Builder& filter(const std::shared_ptr<Expression>& expression);
+
+    Builder& descendants(v_int32 maxDepth = -1);
+
     Path build();
 
     std::shared_ptr<Path> buildShared();
@@ -0,0 +1,497 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "PathParser.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+constexpr const char* const PathParser::ERROR_UNEXPECTED_CHAR;
+constexpr const char* const PathParser::ERROR_UNTERMINATED_STRING;
+constexpr const char* const PathParser::ERROR_INVALID_REFERENCE;
+constexpr const char* const PathParser::ERROR_EMPTY_VARIABLE_NAME;
+constexpr const char* const PathParser::ERROR_ZERO_SLICE_STEP;
+constexpr const char* const PathParser::ERROR_INVALID_OPERAND;
+constexpr const char* const PathParser::ERROR_INVALID_LITERAL;
+constexpr const char* const PathParser::ERROR_INVALID_DEPTH;
+
+oatpp::String PathParser::parseQuotedName(oatpp::parser::Caret& caret) {
+
+  caret.inc(); // skip opening quote
+
+  std::string name;
+  p_char8 data = caret.getData();
+
+  while(caret.canContinue()) {
+
+    v_char8 a = data[caret.getPosition()];
+
+    if(a == '\'') {
+      caret.inc();
+      return oatpp::String(name);
+    }
+
+    if(a == '\\') {
+      caret.inc();
+      if(!caret.canContinue()) {
+        break;
+      }
+      a = data[caret.getPosition()];
+    }
+
+    name.push_back((char) a);
+    caret.inc();
+
+  }
+
+  caret.setError(ERROR_UNTERMINATED_STRING);
+  return nullptr;
+
+}
+
+bool PathParser::parseOptionalInt(oatpp::parser::Caret& caret, v_int64& value) {
+
+  caret.skipBlankChars();
+
+  if(!caret.isAtChar('-') && !caret.isAtDigitChar()) {
+    return false;
+  }
+
+  v_int32 start = caret.getPosition();
+  value = caret.parseInt();
+  if(caret.hasError() || caret.getPosition() == start) {
+    caret.setPosition(start);
+    caret.setError(ERROR_INVALID_REFERENCE);
+    return false;
+  }
+
+  caret.skipBlankChars();
+  return true;
+
+}
+
+Path::Slice PathParser::parseSlice(oatpp::parser::Caret& caret, bool hasStart, v_int64 start) {
+
+  caret.inc(); // skip ':'
+
+  v_int64 end = 0;
+  bool hasEnd = parseOptionalInt(caret, end);
+
+  v_int64 step = 1;
+  if(caret.canContinueAtChar(':', 1) && parseOptionalInt(caret, step) && step == 0) {
+    caret.setError(ERROR_ZERO_SLICE_STEP);
+  }
+
+  return Path::Slice(hasStart, start, hasEnd, end, step);
+
+}
+
+void PathParser::parseFieldCollection(oatpp::parser::Caret& caret, Path::Builder& builder) {
+
+  caret.inc(); // skip '['
+
+  std::vector<Path::FieldReference> references;
+
+  while(caret.canContinue()) {
+
+    caret.skipBlankChars();
+
+    if(caret.isAtChar('\'')) {
+
+      auto name = parseQuotedName(caret);
+      if(caret.hasError()) {
+        return;
+      }
+      references.push_back(Path::FieldReference(name));
+
+    } else if(caret.isAtChar('-') || caret.isAtDigitChar() || caret.isAtChar(':')) {
+
+      v_int64 index = 0;
+      bool hasIndex = parseOptionalInt(caret, index);
+      if(caret.hasError()) {
+        return;
+      }
+
+      if(caret.isAtChar(':')) {
+        references.push_back(Path::FieldReference(parseSlice(caret, hasIndex, index)));
+        if(caret.hasError()) {
+          return;
+        }
+      } else {
+        references.push_back(Path::FieldReference(index));
+      }
+
+    } else {
+      caret.setError(ERROR_INVALID_REFERENCE);
+      return;
+    }
+
+    caret.skipBlankChars();
+
+    if(caret.canContinueAtChar(']', 1)) {
+      builder.fields(references);
+      return;
+    }
+
+    if(!caret.canContinueAtChar(',', 1)) {
+      break;
+    }
+
+  }
+
+  caret.setError(ERROR_UNEXPECTED_CHAR);
+
+}
+
+void PathParser::parseVariable(oatpp::parser::Caret& caret, Path::Builder& builder) {
+
+  caret.inc(); // skip '$'
+
+  auto label = caret.putLabel();
+  p_char8 data = caret.getData();
+
+  while(caret.canContinue()) {
+    v_char8 a = data[caret.getPosition()];
+    if((a >= 'a' && a <= 'z') || (a >= 'A' && a <= 'Z') || (a >= '0' && a <= '9') || a == '_' || a == '-') {
+      caret.inc();
+    } else {
+      break;
+    }
+  }
+
+  if(label.getSize() == 0) {
+    caret.setError(ERROR_EMPTY_VARIABLE_NAME);
+    return;
+  }
+
+  builder.variable(label.toString());
+
+}
+
+std::vector<oatpp::String> PathParser::parseOperand(oatpp::parser::Caret& caret) {
+
+  std::vector<oatpp::String> operand;
+
+  caret.skipBlankChars();
+  if(!caret.canContinueAtChar('@', 1)) {
+    caret.setError(ERROR_INVALID_OPERAND);
+    return operand;
+  }
+
+  p_char8 data = caret.getData();
+
+  while(caret.canContinue()) {
+
+    if(caret.isAtChar('.')) {
+
+      caret.inc();
+      auto label = caret.putLabel();
+      while(caret.canContinue()) {
+        v_char8 a = data[caret.getPosition()];
+        if((a >= 'a' && a <= 'z') || (a >= 'A' && a <= 'Z') || (a >= '0' && a <= '9') || a == '_') {
+          caret.inc();
+        } else {
+          break;
+        }
+      }
+      if(label.getSize() == 0) {
+        caret.setError(ERROR_INVALID_OPERAND);
+        return operand;
+      }
+      operand.push_back(label.toString());
+
+    } else if(caret.isAtText("['")) {
+
+      caret.inc();
+      auto name = parseQuotedName(caret);
+      if(caret.hasError()) {
+        return operand;
+      }
+      if(!caret.canContinueAtChar(']', 1)) {
+        caret.setError(ERROR_INVALID_OPERAND);
+        return operand;
+      }
+      operand.push_back(name);
+
+    } else {
+      break;
+    }
+
+  }
+
+  return operand;
+
+}
+
+Path::Literal PathParser::parseLiteral(oatpp::parser::Caret& caret) {
+
+  caret.skipBlankChars();
+
+  if(caret.isAtChar('\'')) {
+    return Path::Literal(parseQuotedName(caret));
+  } else if(caret.isAtText("true", true)) {
+    return Path::Literal(true);
+  } else if(caret.isAtText("false", true)) {
+    return Path::Literal(false);
+  } else if(caret.isAtText("null", true)) {
+    return Path::Literal();
+  }
+
+  p_char8 data = caret.getData();
+  std::string number;
+  bool isFloat = false;
+
+  while(caret.canContinue()) {
+    v_char8 a = data[caret.getPosition()];
+    if((a >= '0' && a <= '9') || a == '-' || a == '+') {
+      number.push_back((char) a);
+    } else if(a == '.' || a == 'e' || a == 'E') {
+      number.push_back((char) a);
+      isFloat = true;
+    } else {
+      break;
+    }
+    caret.inc();
+  }
+
+  if(!number.empty()) {
+    char* end;
+    if(isFloat) {
+      v_float64 value = std::strtod(number.c_str(), &end);
+      if(*end == 0) {
+        return Path::Literal(value);
+      }
+    } else {
+      v_int64 value = std::strtoll(number.c_str(), &end, 10);
+      if(*end == 0) {
+        return Path::Literal(value);
+      }
+    }
+  }
+
+  caret.setError(ERROR_INVALID_LITERAL);
+  return Path::Literal();
+
+}
+
+std::shared_ptr<Path::Expression> PathParser::parseComparison(oatpp::parser::Caret& caret) {
+
+  static const struct {
+    const char* text;
+    Path::Expression::Operator op;
+  } operators[] = {
+    {"==", Path::Expression::EQ},
+    {"!=", Path::Expression::NE},
+    {"<=", Path::Expression::LE},
+    {">=", Path::Expression::GE},
+    {"^=", Path::Expression::STARTS_WITH},
+    {"<", Path::Expression::LT},
+    {">", Path::Expression::GT}
+  };
+
+  auto operand = parseOperand(caret);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+
+  caret.skipBlankChars();
+
+  for(const auto& op : operators) {
+    if(caret.isAtText(op.text, true)) {
+      auto literal = parseLiteral(caret);
+      if(caret.hasError()) {
+        return nullptr;
+      }
+      return Path::Expression::compare(operand, op.op, literal);
+    }
+  }
+
+  return Path::Expression::exists(operand);
+
+}
+
+std::shared_ptr<Path::Expression> PathParser::parseUnary(oatpp::parser::Caret& caret) {
+
+  caret.skipBlankChars();
+
+  if(caret.isAtChar('!')) {
+    caret.inc();
+    auto expression = parseUnary(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    return Path::Expression::negate(expression);
+  }
+
+  if(caret.isAtChar('(')) {
+    caret.inc();
+    auto expression = parseOr(caret);
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    caret.skipBlankChars();
+    if(!caret.canContinueAtChar(')', 1)) {
+      caret.setError(ERROR_UNEXPECTED_CHAR);
+      return nullptr;
+    }
+    return expression;
+  }
+
+  return parseComparison(caret);
+
+}
+
+std::shared_ptr<Path::Expression> PathParser::parseAnd(oatpp::parser::Caret& caret) {
+
+  std::vector<std::shared_ptr<Path::Expression>> expressions;
+
+  do {
+    expressions.push_back(parseUnary(caret));
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    caret.skipBlankChars();
+  } while(caret.isAtText("&&", true));
+
+  return expressions.size() == 1 ? expressions[0] : Path::Expression::allOf(expressions);
+
+}
+
+std::shared_ptr<Path::Expression> PathParser::parseOr(oatpp::parser::Caret& caret) {
+
+  std::vector<std::shared_ptr<Path::Expression>> expressions;
+
+  do {
+    expressions.push_back(parseAnd(caret));
+    if(caret.hasError()) {
+      return nullptr;
+    }
+    caret.skipBlankChars();
+  } while(caret.isAtText("||", true));
+
+  return expressions.size() == 1 ? expressions[0] : Path::Expression::anyOf(expressions);
+
+}
+
+void PathParser::parseFilter(oatpp::parser::Caret& caret, Path::Builder& builder) {
+
+  caret.inc(); // skip '['
+  caret.inc(); // skip '?'
+  caret.skipBlankChars();
+
+  if(!caret.canContinueAtChar('(', 1)) {
+    caret.setError(ERROR_UNEXPECTED_CHAR);
+    return;
+  }
+
+  auto expression = parseOr(caret);
+  if(caret.hasError()) {
+    return;
+  }
+
+  caret.skipBlankChars();
+  if(!caret.canContinueAtChar(')', 1)) {
+    caret.setError(ERROR_UNEXPECTED_CHAR);
+    return;
+  }
+
+  caret.skipBlankChars();
+  if(!caret.canContinueAtChar(']', 1)) {
+    caret.setError(ERROR_UNEXPECTED_CHAR);
+    return;
+  }
+
+  builder.filter(expression);
+
+}
+
+void PathParser::parseRecursiveDescent(oatpp::parser::Caret& caret, Path::Builder& builder) {
+
+  caret.inc(2); // skip '..'
+
+  if(!caret.isAtChar('{')) {
+    builder.descendants();
+    return;
+  }
+
+  caret.inc();
+
+  v_int64 maxDepth;
+  if(!parseOptionalInt(caret, maxDepth) || maxDepth < 0 || maxDepth > 0x7FFFFFFF) {
+    caret.setError(ERROR_INVALID_DEPTH);
+    return;
+  }
+
+  if(!caret.canContinueAtChar('}', 1)) {
+    caret.setError(ERROR_UNEXPECTED_CHAR);
+    return;
+  }
+
+  builder.descendants((v_int32) maxDepth);
+
+}
+
+std::shared_ptr<Path> PathParser::parse(const oatpp::String& text) {
+
+  oatpp::parser::Caret caret(text);
+  Path::Builder builder;
+
+  while(caret.skipBlankChars() && !caret.hasError()) {
+
+    if(caret.isAtChar('/')) {
+      caret.inc();
+      builder.reRoot();
+    } else if(caret.isAtText("..")) {
+      parseRecursiveDescent(caret, builder);
+    } else if(caret.isAtChar('.')) {
+      caret.inc();
+      builder.selectFields();
+    } else if(caret.isAtChar('*')) {
+      caret.inc();
+      builder.variable(nullptr);
+    } else if(caret.isAtChar('$')) {
+      parseVariable(caret, builder);
+    } else if(caret.isAtText("[?")) {
+      parseFilter(caret, builder);
+    } else if(caret.isAtChar('[')) {
+      parseFieldCollection(caret, builder);
+    } else {
+      caret.setError(ERROR_UNEXPECTED_CHAR);
+    }
+
+  }
+
+  if(caret.hasError()) {
+    throw std::runtime_error("[oatpp::dtoql::PathParser::parse()]: Error. " + std::string(caret.getErrorMessage()) +
+                             " at position " + std::to_string(caret.getPosition()) + ".");
+  }
+
+  return builder.buildShared();
+
+}
+
+}}
@@ -0,0 +1,79 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_dtoql_PathParser_hpp
+#define oatpp_dtoql_PathParser_hpp
+
+#include "./Path.hpp"
+
+#include "oatpp/core/parser/Caret.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Parser of the text form produced by &l:Path::toString ();. <br>
+ * Grammar: `/` - re-root, `.` - field selector, `['name', 12, -1, 0:10:2, ...]` - field collection,
+ * `*` - anonymous variable, `$name` - named variable, `[?(@.a.b > 5 && !(@['c'] ^= 'x') || @.d)]` - filter,
+ * `..` - recursive descent, `..{3}` - recursive descent with max depth.
+ * Blank chars between components are ignored.
+ */
+class PathParser {
+public:
+  static constexpr const char* const ERROR_UNEXPECTED_CHAR = "Unexpected char";
+  static constexpr const char* const ERROR_UNTERMINATED_STRING = "Unterminated string";
+  static constexpr const char* const ERROR_INVALID_REFERENCE = "Invalid field reference";
+  static constexpr const char* const ERROR_EMPTY_VARIABLE_NAME = "Empty variable name";
+  static constexpr const char* const ERROR_ZERO_SLICE_STEP = "Slice step can't be zero";
+  static constexpr const char* const ERROR_INVALID_OPERAND = "Invalid filter operand";
+  static constexpr const char* const ERROR_INVALID_LITERAL = "Invalid filter literal";
+  static constexpr const char* const ERROR_INVALID_DEPTH = "Invalid max depth";
+private:
+  static bool parseOptionalInt(oatpp::parser::Caret& caret, v_int64& value);
+  static Path::Slice parseSlice(oatpp::parser::Caret& caret, bool hasStart, v_int64 start);
+  static oatpp::String parseQuotedName(oatpp::parser::Caret& caret);
+  static void parseFieldCollection(oatpp::parser::Caret& caret, Path::Builder& builder);
+  static void parseVariable(oatpp::parser::Caret& caret, Path::Builder& builder);
+  static std::vector<oatpp::String> parseOperand(oatpp::parser::Caret& caret);
+  static Path::Literal parseLiteral(oatpp::parser::Caret& caret);
+  static std::shared_ptr<Path::Expression> parseComparison(oatpp::parser::Caret& caret);
+  static std::shared_ptr<Path::Expression> parseUnary(oatpp::parser::Caret& caret);
+  static std::shared_ptr<Path::Expression> parseAnd(oatpp::parser::Caret& caret);
+  static std::shared_ptr<Path::Expression> parseOr(oatpp::parser::Caret& caret);
+  static void parseFilter(oatpp::parser::Caret& caret, Path::Builder& builder);
+  static void parseRecursiveDescent(oatpp::parser::Caret& caret, Path::Builder& builder);
+public:
+
+  /**
+   * Parse path.
+   * @param text - path text.
+   * @return - &l:Path;.
+   * @throws - `std::runtime_error` on syntax error.
+   */
+  static std::shared_ptr<Path> parse(const oatpp::String& text);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_PathParser_hpp
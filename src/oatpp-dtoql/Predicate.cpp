@@ -0,0 +1,260 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Predicate.hpp"
+#include "ValueUtils.hpp"
+
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/data/mapping/type/Object.hpp"
+#include "oatpp/core/data/mapping/type/Primitive.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace dtoql {
+
+Predicate::Predicate(const std::shared_ptr<Path::Expression>& expression)
+  : m_root(compile(*expression))
+{
+  m_indexable = findIndexable(m_root);
+}
+
+Predicate::Node Predicate::compile(const Path::Expression& expression) {
+
+  Node node;
+  node.type = expression.getType();
+  node.op = expression.getOperator();
+
+  for(const auto& name : expression.getOperand()) {
+    node.operand.push_back(name->std_str());
+  }
+
+  const auto& literal = expression.getLiteral();
+  node.literalType = literal.getType();
+  node.boolean = literal.getBoolean();
+  node.integer = literal.getInteger();
+  node.number = literal.getType() == Path::Literal::INTEGER ? (v_float64) literal.getInteger() : literal.getFloat();
+  if(literal.getType() == Path::Literal::STRING) {
+    node.string = literal.getString()->std_str();
+  }
+
+  for(const auto& child : expression.getChildren()) {
+    node.children.push_back(compile(*child));
+  }
+
+  return node;
+
+}
+
+const Predicate::Node* Predicate::findIndexable(const Node& node) {
+
+  if(node.type == Path::Expression::COMPARISON) {
+    if(node.op >= Path::Expression::EQ && node.op <= Path::Expression::GE && node.op != Path::Expression::NE &&
+       node.literalType != Path::Literal::NULL_VALUE)
+    {
+      return &node;
+    }
+    return nullptr;
+  }
+
+  if(node.type == Path::Expression::AND) {
+    for(const auto& child : node.children) {
+      if(child.type == Path::Expression::COMPARISON) {
+        auto comparison = findIndexable(child);
+        if(comparison) {
+          return comparison;
+        }
+      }
+    }
+  }
+
+  return nullptr;
+
+}
+
+const Predicate::AbstractObjectWrapper* Predicate::resolve(const AbstractObjectWrapper* value, const std::vector<std::string>& operand) {
+
+  namespace type = oatpp::data::mapping::type;
+  typedef type::ListMap<oatpp::String, AbstractObjectWrapper> AbstractFieldsMap;
+
+  for(const auto& name : operand) {
+
+    if(!*value) {
+      return nullptr;
+    }
+
+    auto classId = value->valueType->classId.id;
+
+    if(classId == type::__class::AbstractObject::CLASS_ID.id) {
+
+      const auto& properties = value->valueType->properties->getMap();
+      auto it = properties.find(name);
+      if(it == properties.end()) {
+        return nullptr;
+      }
+      auto object = static_cast<const type::Object*>(value->get());
+      value = (const AbstractObjectWrapper*) ((const v_char8*) object + it->second->offset);
+
+    } else if(classId == type::__class::AbstractListMap::CLASS_ID.id) {
+
+      auto map = static_cast<const AbstractFieldsMap*>(value->get());
+      auto entry = map->getFirstEntry();
+      while(entry != nullptr) {
+        const auto& key = entry->getKey();
+        if(key && key->getSize() == (v_int32) name.size() && std::memcmp(key->getData(), name.data(), name.size()) == 0) {
+          break;
+        }
+        entry = entry->getNext();
+      }
+      if(entry == nullptr) {
+        return nullptr;
+      }
+      value = &entry->getValue();
+
+    } else {
+      return nullptr;
+    }
+
+  }
+
+  return value;
+
+}
+
+bool Predicate::compare(const Node& node, const AbstractObjectWrapper* value) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(value == nullptr || !*value) {
+    bool isNull = node.literalType == Path::Literal::NULL_VALUE;
+    return node.op == Path::Expression::EQ ? isNull : (node.op == Path::Expression::NE ? !isNull : false);
+  }
+
+  if(node.literalType == Path::Literal::NULL_VALUE) {
+    return node.op == Path::Expression::NE;
+  }
+
+  auto classId = value->valueType->classId.id;
+  v_int32 result; // <0, 0, >0
+  bool isInteger = false;
+  v_int64 integer = 0;
+  v_float64 number = 0;
+
+  if(ValueUtils::readNumber(*value, integer, number, isInteger)) {
+
+    if(node.literalType == Path::Literal::INTEGER && isInteger) {
+      result = integer < node.integer ? -1 : (integer > node.integer ? 1 : 0);
+    } else if(node.literalType == Path::Literal::INTEGER || node.literalType == Path::Literal::FLOAT) {
+      v_float64 a = isInteger ? (v_float64) integer : number;
+      result = a < node.number ? -1 : (a > node.number ? 1 : 0);
+    } else {
+      return node.op == Path::Expression::NE;
+    }
+
+  } else if(classId == type::__class::String::CLASS_ID.id) {
+
+    if(node.literalType != Path::Literal::STRING) {
+      return node.op == Path::Expression::NE;
+    }
+
+    auto str = static_cast<oatpp::base::StrBuffer*>(value->get());
+    v_int32 size = str->getSize();
+    v_int32 literalSize = (v_int32) node.string.size();
+
+    if(node.op == Path::Expression::STARTS_WITH) {
+      return size >= literalSize && std::memcmp(str->getData(), node.string.data(), literalSize) == 0;
+    }
+
+    result = std::memcmp(str->getData(), node.string.data(), size < literalSize ? size : literalSize);
+    if(result == 0) {
+      result = size - literalSize;
+    }
+
+  } else if(classId == type::__class::Boolean::CLASS_ID.id) {
+
+    if(node.literalType != Path::Literal::BOOLEAN) {
+      return node.op == Path::Expression::NE;
+    }
+
+    bool b = static_cast<type::Primitive<bool, type::__class::Boolean>*>(value->get())->getValue();
+    result = (v_int32) b - (v_int32) node.boolean;
+
+  } else {
+    return node.op == Path::Expression::NE;
+  }
+
+  switch(node.op) {
+    case Path::Expression::EQ: return result == 0;
+    case Path::Expression::NE: return result != 0;
+    case Path::Expression::LT: return result < 0;
+    case Path::Expression::LE: return result <= 0;
+    case Path::Expression::GT: return result > 0;
+    case Path::Expression::GE: return result >= 0;
+    default: return false;
+  }
+
+}
+
+bool Predicate::evaluate(const Node& node, const AbstractObjectWrapper& value) {
+
+  switch(node.type) {
+
+    case Path::Expression::COMPARISON:
+      return compare(node, resolve(&value, node.operand));
+
+    case Path::Expression::EXISTS: {
+      auto operand = resolve(&value, node.operand);
+      return operand != nullptr && *operand;
+    }
+
+    case Path::Expression::AND:
+      for(const auto& child : node.children) {
+        if(!evaluate(child, value)) return false;
+      }
+      return true;
+
+    case Path::Expression::OR:
+      for(const auto& child : node.children) {
+        if(evaluate(child, value)) return true;
+      }
+      return false;
+
+    case Path::Expression::NOT:
+      return !evaluate(node.children[0], value);
+
+  }
+
+  return false;
+
+}
+
+bool Predicate::test(const AbstractObjectWrapper& value) const {
+  return evaluate(m_root, value);
+}
+
+const Predicate::Node* Predicate::getIndexableComparison() const {
+  return m_indexable;
+}
+
+}}
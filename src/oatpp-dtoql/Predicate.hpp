@@ -0,0 +1,105 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Predicate_hpp
+#define oatpp_dtoql_Predicate_hpp
+
+#include "./Path.hpp"
+
+#include "oatpp/core/data/mapping/type/Type.hpp"
+
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Compiled &l:Path::Expression;. <br>
+ * Comparisons are defined for `String`, integer, float and `Boolean` primitives. Integers and floats compare with each other.
+ * Comparison of mismatched types is `false`, except for `!=` which is `true`. Missing and `null` values equal only `null`.
+ * `^=` is true if the string starts with the literal. <br>
+ * Predicate is immutable and can be shared between threads.
+ */
+class Predicate {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+public:
+
+  /**
+   * Compiled expression node.
+   */
+  struct Node {
+    v_int32 type;
+    v_int32 op;
+    std::vector<std::string> operand;
+    v_int32 literalType;
+    bool boolean;
+    v_int64 integer;
+    v_float64 number;
+    std::string string;
+    std::vector<Node> children;
+  };
+
+private:
+  static Node compile(const Path::Expression& expression);
+  static const Node* findIndexable(const Node& node);
+  static bool compare(const Node& node, const AbstractObjectWrapper* value);
+  static bool evaluate(const Node& node, const AbstractObjectWrapper& value);
+private:
+  Node m_root;
+  const Node* m_indexable;
+public:
+
+  Predicate(const std::shared_ptr<Path::Expression>& expression);
+
+  Predicate(const Predicate& other) = delete;
+  Predicate& operator=(const Predicate& other) = delete;
+
+  /**
+   * Test value.
+   * @param value - candidate value. Operands are resolved relative to it.
+   * @return
+   */
+  bool test(const AbstractObjectWrapper& value) const;
+
+  /**
+   * Get comparison which must hold for the predicate to be true and which can be answered by &l:ValueIndex; -
+   * `==`, `<`, `<=`, `>`, `>=` with non-null literal, either the whole predicate or a direct term of `&&`.
+   * @return - comparison node or `nullptr`.
+   */
+  const Node* getIndexableComparison() const;
+
+  /**
+   * Resolve operand relative to the value. Names are looked up in objects and `Fields` maps.
+   * @param value - value.
+   * @param operand - names.
+   * @return - pointer to the resolved value or `nullptr` if it is missing.
+   */
+  static const AbstractObjectWrapper* resolve(const AbstractObjectWrapper* value, const std::vector<std::string>& operand);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Predicate_hpp
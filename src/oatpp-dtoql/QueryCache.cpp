@@ -0,0 +1,81 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "QueryCache.hpp"
+
+#include "./PathParser.hpp"
+
+namespace oatpp { namespace dtoql {
+
+QueryCache::QueryCache(v_int32 maxSize)
+  : m_maxSize(maxSize)
+{}
+
+std::shared_ptr<CompiledPath> QueryCache::get(const oatpp::String& query) {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(query);
+    if(it != m_index.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second);
+      return it->second->second;
+    }
+  }
+
+  /* parse outside of the lock - it's ok if two threads compile the same query concurrently */
+  auto plan = CompiledPath::compile(PathParser::parse(query));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_index.find(query);
+  if(it != m_index.end()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->second;
+  }
+
+  m_lru.push_front(std::make_pair(query, plan));
+  m_index.insert(std::make_pair(query, m_lru.begin()));
+
+  while(m_lru.size() > m_maxSize) {
+    m_index.erase(m_lru.back().first);
+    m_lru.pop_back();
+  }
+
+  return plan;
+
+}
+
+v_int32 QueryCache::getSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return (v_int32) m_lru.size();
+}
+
+void QueryCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_index.clear();
+  m_lru.clear();
+}
+
+}}
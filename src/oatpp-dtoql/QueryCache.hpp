@@ -0,0 +1,73 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_QueryCache_hpp
+#define oatpp_dtoql_QueryCache_hpp
+
+#include "./CompiledPath.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Thread-safe bounded LRU cache of compiled queries keyed by query text. <br>
+ * Queries are parsed with &l:PathParser; and compiled to &l:CompiledPath; on first use only.
+ */
+class QueryCache {
+private:
+  typedef std::list<std::pair<oatpp::String, std::shared_ptr<CompiledPath>>> LruList;
+private:
+  std::mutex m_mutex;
+  v_int32 m_maxSize;
+  LruList m_lru;
+  std::unordered_map<oatpp::String, LruList::iterator> m_index;
+public:
+
+  /**
+   * Constructor.
+   * @param maxSize - max number of compiled queries to keep.
+   */
+  QueryCache(v_int32 maxSize = 512);
+
+  /**
+   * Get compiled query. Parse and compile it if it's not in cache.
+   * @param query - query text.
+   * @return - `std::shared_ptr` to &l:CompiledPath;.
+   * @throws - `std::runtime_error` if query can't be parsed.
+   */
+  std::shared_ptr<CompiledPath> get(const oatpp::String& query);
+
+  v_int32 getSize();
+
+  void clear();
+
+};
+
+}}
+
+#endif // oatpp_dtoql_QueryCache_hpp
@@ -0,0 +1,73 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "QueryCoroutine.hpp"
+
+namespace oatpp { namespace dtoql {
+
+QueryCoroutine::QueryCoroutine(const std::shared_ptr<CompiledPath>& plan,
+                               const Executor::AbstractObjectWrapper& root,
+                               const std::shared_ptr<AsyncRowSink>& sink,
+                               v_int64 stepsPerSlice)
+  : m_executor(plan, root)
+  , m_sink(sink)
+  , m_stepsPerSlice(stepsPerSlice > 0 ? stepsPerSlice : 1)
+  , m_rowsCount(0)
+{}
+
+oatpp::async::Action QueryCoroutine::finishQuery() {
+  m_sink->onFinished(m_rowsCount);
+  return finish();
+}
+
+oatpp::async::Action QueryCoroutine::act() {
+
+  v_int64 budget = m_stepsPerSlice;
+
+  while(true) {
+
+    switch(m_executor.advance(budget)) {
+
+      case Executor::ROW:
+        m_rowsCount ++;
+        if(m_sink->onRow(m_executor.getRow()) == Executor::RowVisitor::STOP) {
+          return finishQuery();
+        }
+        break;
+
+      case Executor::YIELD:
+        m_sink->onSliceEnd();
+        return repeat();
+
+      case Executor::FINISHED:
+        return finishQuery();
+
+    }
+
+  }
+
+}
+
+}}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_QueryCoroutine_hpp
+#define oatpp_dtoql_QueryCoroutine_hpp
+
+#include "./Executor.hpp"
+
+#include "oatpp/core/async/Coroutine.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Receiver of rows of &l:QueryCoroutine;. <br>
+ * Rows are delivered within scheduling slices, so `onRow` must not block.
+ */
+class AsyncRowSink : public Executor::RowVisitor {
+public:
+
+  /**
+   * Called before the coroutine yields. Good place to hand buffered rows over to a consumer.
+   */
+  virtual void onSliceEnd() {}
+
+  /**
+   * Called once when the query is finished or stopped by the sink.
+   * @param rowsCount - total rows delivered.
+   */
+  virtual void onFinished(v_int64 rowsCount) {}
+
+};
+
+/**
+ * Runs query on &id:oatpp::async::Executor; cooperatively. <br>
+ * Each scheduling slice performs at most `stepsPerSlice` steps of &l:Executor::advance (); and then yields,
+ * so heavy queries do not stall other coroutines of the worker.
+ */
+class QueryCoroutine : public oatpp::async::Coroutine<QueryCoroutine> {
+private:
+  Executor m_executor;
+  std::shared_ptr<AsyncRowSink> m_sink;
+  v_int64 m_stepsPerSlice;
+  v_int64 m_rowsCount;
+private:
+  Action finishQuery();
+public:
+
+  /**
+   * Constructor.
+   * @param plan - &l:CompiledPath;.
+   * @param root - root object. Must not be modified while the coroutine is running.
+   * @param sink - &l:AsyncRowSink;.
+   * @param stepsPerSlice - steps budget of one scheduling slice.
+   */
+  QueryCoroutine(const std::shared_ptr<CompiledPath>& plan,
+                 const Executor::AbstractObjectWrapper& root,
+                 const std::shared_ptr<AsyncRowSink>& sink,
+                 v_int64 stepsPerSlice = 1024);
+
+  Action act() override;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_QueryCoroutine_hpp
@@ -0,0 +1,183 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "QuerySet.hpp"
+
+#include <limits>
+
+namespace oatpp { namespace dtoql {
+
+QuerySet::QuerySet()
+  : m_queriesCount(0)
+  , m_depth(0)
+{
+  m_nodes.push_back(Node{"", -1, {}, {}});
+}
+
+std::string QuerySet::getKey(const std::shared_ptr<Path::Component>& component) {
+  if(component->getType() == Path::ComponentType::VARIABLE) {
+    return "*"; // variable name has no effect on selection
+  }
+  return Path({component}).toString()->std_str();
+}
+
+v_int32 QuerySet::add(const std::shared_ptr<Path>& path) {
+
+  v_int32 nodeIndex = 0;
+  v_int32 depth = 0;
+
+  for(const auto& component : path->getComponents()) {
+
+    auto type = component->getType();
+    if(type != Path::ComponentType::FIELD_COLLECTION && type != Path::ComponentType::VARIABLE && type != Path::ComponentType::FILTER &&
+       type != Path::ComponentType::RECURSIVE_DESCENT)
+    {
+      continue;
+    }
+
+    auto key = getKey(component);
+
+    v_int32 next = -1;
+    for(v_int32 child : m_nodes[nodeIndex].children) {
+      if(m_nodes[child].key == key) {
+        next = child;
+        break;
+      }
+    }
+
+    if(next < 0) {
+      next = (v_int32) m_nodes.size();
+      m_nodes.push_back(Node{key, (v_int32) m_components.size(), {}, {}});
+      m_nodes[nodeIndex].children.push_back(next);
+      if(type == Path::ComponentType::VARIABLE) {
+        m_components.push_back(std::make_shared<Path::Variable>(nullptr)); // names of different queries may clash
+      } else {
+        m_components.push_back(component);
+      }
+    }
+
+    nodeIndex = next;
+    depth ++;
+
+  }
+
+  m_nodes[nodeIndex].queries.push_back(m_queriesCount);
+
+  if(depth > m_depth) {
+    m_depth = depth;
+  }
+
+  /* instruction i of the plan is the selection of trie node with `instruction == i` */
+  m_plan = CompiledPath::compile(std::make_shared<Path>(m_components));
+
+  return m_queriesCount ++;
+
+}
+
+v_int32 QuerySet::getQueriesCount() const {
+  return m_queriesCount;
+}
+
+v_int32 QuerySet::getSelectionsCount() const {
+  return (v_int32) m_components.size();
+}
+
+bool QuerySet::visit(Context& context, v_int32 nodeIndex, v_int32 level, const Executor::AbstractObjectWrapper& value) const {
+
+  for(v_int32 childIndex : m_nodes[nodeIndex].children) {
+
+    const Node& child = m_nodes[childIndex];
+    auto& selection = context.selections[level + 1];
+    auto& frame = context.frames[level + 1];
+
+    context.executor.select(m_plan, child.instruction, value, selection);
+    frame.fields = selection.data();
+    frame.size = (v_int32) selection.size();
+
+    for(v_int32 i = 0; i < frame.size; i ++) {
+
+      frame.position = i + 1;
+      if(level + 1 < context.changedLevel) {
+        context.changedLevel = level + 1;
+      }
+
+      for(v_int32 queryId : child.queries) {
+        Executor::Row row(context.frames.data(), level + 2, std::min(context.changedLevel, level + 2), nullptr);
+        context.changedLevel = std::numeric_limits<v_int32>::max();
+        context.rowsCount ++;
+        if(context.visitor->onRow(queryId, row) == Executor::RowVisitor::STOP) {
+          return false;
+        }
+      }
+
+      if(!child.children.empty() && !visit(context, childIndex, level + 1, *selection[i].value)) {
+        return false;
+      }
+
+    }
+
+  }
+
+  return true;
+
+}
+
+v_int64 QuerySet::execute(const Executor::AbstractObjectWrapper& root, RowVisitor& visitor) const {
+
+  Executor::AbstractObjectWrapper rootValue = root;
+  Executor::FieldView rootField{nullptr, 0, nullptr, 0, &rootValue};
+
+  Context context;
+  context.selections.resize(m_depth + 1);
+  context.frames.resize(m_depth + 1, Executor::Frame{nullptr, 0, 0, Arena::Mark{0, 0}});
+  context.frames[0] = Executor::Frame{&rootField, 1, 1, Arena::Mark{0, 0}};
+  context.changedLevel = 0;
+  context.rowsCount = 0;
+  context.visitor = &visitor;
+
+  /* queries with no selections yield the root itself */
+  for(v_int32 queryId : m_nodes[0].queries) {
+    Executor::Row row(context.frames.data(), 1, context.changedLevel, nullptr);
+    context.changedLevel = std::numeric_limits<v_int32>::max();
+    context.rowsCount ++;
+    if(visitor.onRow(queryId, row) == Executor::RowVisitor::STOP) {
+      return context.rowsCount;
+    }
+  }
+
+  if(m_plan) {
+    visit(context, 0, 0, rootValue);
+  }
+
+  return context.rowsCount;
+
+}
+
+v_int64 QuerySet::execute(const Executor::AbstractObjectWrapper& root, const RowCallback& callback) const {
+  CallbackRowVisitor visitor(callback);
+  return execute(root, visitor);
+}
+
+}}
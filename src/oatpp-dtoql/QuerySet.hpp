@@ -0,0 +1,135 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_QuerySet_hpp
+#define oatpp_dtoql_QuerySet_hpp
+
+#include "./Executor.hpp"
+
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Set of queries evaluated together in one traversal. <br>
+ * Paths are merged into a trie of components - a prefix shared by several queries is selected once.
+ * All trie nodes are compiled into one &l:CompiledPath; so that selections share the plan caches. <br>
+ * Rows of each query come in the same order as if the query was executed alone.
+ */
+class QuerySet {
+public:
+
+  /**
+   * Consumer of rows of &l:QuerySet;.
+   */
+  class RowVisitor {
+  public:
+    virtual ~RowVisitor() = default;
+
+    /**
+     * Called for each row of each query.
+     * @param queryId - id returned by &l:QuerySet::add ();.
+     * @param row - &l:Executor::Row;. Changed level is relative to the previous row of any query.
+     * @return - &l:Executor::RowVisitor::Action;.
+     */
+    virtual Executor::RowVisitor::Action onRow(v_int32 queryId, const Executor::Row& row) = 0;
+  };
+
+  typedef std::function<Executor::RowVisitor::Action (v_int32, const Executor::Row&)> RowCallback;
+
+private:
+
+  class CallbackRowVisitor : public RowVisitor {
+  private:
+    const RowCallback& m_callback;
+  public:
+    CallbackRowVisitor(const RowCallback& callback) : m_callback(callback) {}
+    Executor::RowVisitor::Action onRow(v_int32 queryId, const Executor::Row& row) override {
+      return m_callback(queryId, row);
+    }
+  };
+
+private:
+
+  struct Node {
+    std::string key;
+    v_int32 instruction;
+    std::vector<v_int32> children;
+    std::vector<v_int32> queries;
+  };
+
+  struct Context {
+    Executor executor;
+    std::vector<std::vector<Executor::FieldView>> selections;
+    std::vector<Executor::Frame> frames;
+    v_int32 changedLevel;
+    v_int64 rowsCount;
+    RowVisitor* visitor;
+  };
+
+private:
+  static std::string getKey(const std::shared_ptr<Path::Component>& component);
+private:
+  bool visit(Context& context, v_int32 nodeIndex, v_int32 level, const Executor::AbstractObjectWrapper& value) const;
+private:
+  std::vector<Node> m_nodes;
+  std::vector<std::shared_ptr<Path::Component>> m_components;
+  std::shared_ptr<CompiledPath> m_plan;
+  v_int32 m_queriesCount;
+  v_int32 m_depth;
+public:
+
+  QuerySet();
+
+  /**
+   * Add query.
+   * @param path - &l:Path;.
+   * @return - query id. Ids are assigned sequentially starting from `0`.
+   */
+  v_int32 add(const std::shared_ptr<Path>& path);
+
+  v_int32 getQueriesCount() const;
+
+  /**
+   * Number of distinct selections to evaluate for all queries.
+   * @return
+   */
+  v_int32 getSelectionsCount() const;
+
+  /**
+   * Execute all queries. Thread-safe as long as no queries are added concurrently.
+   * @param root - root object.
+   * @param visitor - &l:QuerySet::RowVisitor;. Return `STOP` to terminate early.
+   * @return - number of rows visited.
+   */
+  v_int64 execute(const Executor::AbstractObjectWrapper& root, RowVisitor& visitor) const;
+
+  v_int64 execute(const Executor::AbstractObjectWrapper& root, const RowCallback& callback) const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_QuerySet_hpp
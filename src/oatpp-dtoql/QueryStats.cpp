@@ -0,0 +1,152 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "QueryStats.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace oatpp { namespace dtoql {
+
+QueryStats::QueryStats()
+  : m_plan(nullptr)
+  , m_queriesCount(0)
+  , m_rowsCount(0)
+{}
+
+void QueryStats::onQuery(const std::shared_ptr<CompiledPath>& plan) {
+  if(m_plan != plan) {
+    m_plan = plan;
+    m_components.assign(plan->getInstructionsCount(), ComponentStats{0, 0, 0, 0, 0, 0});
+    m_queriesCount = 0;
+    m_rowsCount = 0;
+  }
+  m_queriesCount ++;
+}
+
+const std::vector<QueryStats::ComponentStats>& QueryStats::getComponents() const {
+  return m_components;
+}
+
+v_int64 QueryStats::getQueriesCount() const {
+  return m_queriesCount;
+}
+
+v_int64 QueryStats::getRowsCount() const {
+  return m_rowsCount;
+}
+
+void QueryStats::reset() {
+  m_plan = nullptr;
+  m_components.clear();
+  m_queriesCount = 0;
+  m_rowsCount = 0;
+}
+
+oatpp::String QueryStats::explain(const CompiledPath& plan) const {
+
+  auto path = plan.getPath();
+  std::string pathText = path ? path->toString()->std_str() : "";
+
+  /* each component is printed at its column in the path text */
+
+  std::vector<std::string> texts;
+  std::vector<size_t> columns;
+  std::vector<v_int32> instructions;
+
+  if(path) {
+    size_t column = 0;
+    for(const auto& component : path->getComponents()) {
+      std::string text = Path({component}).toString()->std_str();
+      size_t position = pathText.find(text, column);
+      if(position == std::string::npos) {
+        position = column;
+      }
+      texts.push_back(text);
+      columns.push_back(position);
+      instructions.push_back(-1);
+      column = position + text.size();
+    }
+  }
+
+  for(v_int32 i = 0; i < plan.getInstructionsCount(); i ++) {
+    v_int32 componentIndex = plan.getInstructions()[i].componentIndex;
+    if(componentIndex >= 0 && componentIndex < (v_int32) instructions.size() && instructions[componentIndex] < 0) {
+      instructions[componentIndex] = i;
+    } else {
+      texts.push_back("#" + std::to_string(i));
+      columns.push_back(0);
+      instructions.push_back(i);
+    }
+  }
+
+  size_t width = pathText.size();
+  for(size_t i = 0; i < texts.size(); i ++) {
+    if(columns[i] + texts[i].size() > width) {
+      width = columns[i] + texts[i].size();
+    }
+  }
+  if(width < 9) {
+    width = 9;
+  }
+
+  std::string result;
+  char line[256];
+
+  std::snprintf(line, sizeof(line), "queries: %lld, rows: %lld\n", (long long) m_queriesCount, (long long) m_rowsCount);
+  result.append(line);
+
+  result.append("component");
+  result.append(width - 9, ' ');
+  std::snprintf(line, sizeof(line), " %10s %10s %10s %10s %12s %10s\n", "visits", "selected", "misses", "rejected", "time(us)", "alloc(B)");
+  result.append(line);
+
+  result.append(pathText);
+  result.append("\n");
+
+  for(size_t i = 0; i < texts.size(); i ++) {
+
+    result.append(columns[i], ' ');
+    result.append(texts[i]);
+    result.append(width - columns[i] - texts[i].size(), ' ');
+
+    v_int32 instruction = instructions[i];
+    if(instruction >= 0 && instruction < (v_int32) m_components.size() && m_plan.get() == &plan) {
+      const auto& s = m_components[instruction];
+      std::snprintf(line, sizeof(line), " %10lld %10lld %10lld %10lld %12.3f %10lld\n",
+                    (long long) s.visits, (long long) s.selected, (long long) s.misses, (long long) s.rejected,
+                    s.time / 1000.0, (long long) s.allocated);
+    } else {
+      std::snprintf(line, sizeof(line), " %10s %10s %10s %10s %12s %10s\n", "-", "-", "-", "-", "-", "-");
+    }
+    result.append(line);
+
+  }
+
+  return oatpp::String(result.data(), (v_int32) result.size(), true);
+
+}
+
+}}
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_QueryStats_hpp
+#define oatpp_dtoql_QueryStats_hpp
+
+#include "./CompiledPath.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Execution statistics per plan instruction. Filled by &l:Executor; when set with &l:Executor::setStats ();. <br>
+ * Stats accumulate over queries of the same plan, so they can be sampled over many executions.
+ * Collection is compiled out with `-D OATPP_DTOQL_DISABLE_STATS`.
+ */
+class QueryStats {
+public:
+
+  struct ComponentStats {
+
+    /**
+     * Values the component was applied to.
+     */
+    v_int64 visits;
+
+    /**
+     * Fields selected, after filter.
+     */
+    v_int64 selected;
+
+    /**
+     * Visits which selected nothing - null or primitive values, no requested fields found.
+     * Visits whose fields were all rejected by filter are not misses.
+     */
+    v_int64 misses;
+
+    /**
+     * Fields rejected by filter.
+     */
+    v_int64 rejected;
+
+    /**
+     * Time spent selecting, nanoseconds.
+     */
+    v_int64 time;
+
+    /**
+     * Bytes of executor arena growth - heap allocations made while selecting.
+     */
+    v_int64 allocated;
+
+  };
+
+private:
+  std::shared_ptr<CompiledPath> m_plan;
+  std::vector<ComponentStats> m_components;
+  v_int64 m_queriesCount;
+  v_int64 m_rowsCount;
+public:
+
+  QueryStats();
+
+  /**
+   * Called by executor when a query starts. Stats are cleared if the plan is different from the previous one.
+   * The plan is held until stats are reset or switched to another plan, so its address can not be reused meanwhile.
+   * @param plan - &l:CompiledPath;.
+   */
+  void onQuery(const std::shared_ptr<CompiledPath>& plan);
+
+  void onRow() {
+    m_rowsCount ++;
+  }
+
+  ComponentStats& getComponentStats(v_int32 instruction) {
+    return m_components[instruction];
+  }
+
+  /**
+   * Get stats per instruction, in the order of &l:CompiledPath::getInstructions ();.
+   * @return
+   */
+  const std::vector<ComponentStats>& getComponents() const;
+
+  v_int64 getQueriesCount() const;
+  v_int64 getRowsCount() const;
+
+  /**
+   * Clear stats.
+   */
+  void reset();
+
+  /**
+   * Render stats as a table - one line per path component, placed under its position in &l:Path::toString ();.
+   * @param plan - plan the stats were collected for.
+   * @return - text.
+   */
+  oatpp::String explain(const CompiledPath& plan) const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_QueryStats_hpp
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResultTree.hpp"
+
+namespace oatpp { namespace dtoql {
+
+ResultTree::Action ResultTree::onRow(const Executor::Row& row) {
+
+  m_currentPath.resize(row.getSize());
+
+  for(v_int32 level = row.getChangedLevel(); level < row.getSize(); level ++) {
+    const auto& view = row[level];
+    v_int32 parent = level > 0 ? m_currentPath[level - 1] : -1;
+    m_currentPath[level] = (v_int32) m_nodes.size();
+    m_nodes.push_back(Node{parent, level, Traverser::Field(view.getName(), view.index, *view.value)});
+  }
+
+  m_leaves.push_back(m_currentPath[row.getSize() - 1]);
+
+  return CONTINUE;
+
+}
+
+const std::vector<ResultTree::Node>& ResultTree::getNodes() const {
+  return m_nodes;
+}
+
+const std::vector<v_int32>& ResultTree::getLeaves() const {
+  return m_leaves;
+}
+
+v_int32 ResultTree::getRowsCount() const {
+  return (v_int32) m_leaves.size();
+}
+
+void ResultTree::getRow(v_int32 index, std::vector<Traverser::Field>& row) const {
+  v_int32 node = m_leaves[index];
+  row.resize(m_nodes[node].level + 1);
+  while(node >= 0) {
+    row[m_nodes[node].level] = m_nodes[node].field;
+    node = m_nodes[node].parent;
+  }
+}
+
+std::vector<std::vector<Traverser::Field>> ResultTree::toTable() const {
+  std::vector<std::vector<Traverser::Field>> result(m_leaves.size());
+  for(v_int32 i = 0; i < m_leaves.size(); i ++) {
+    getRow(i, result[i]);
+  }
+  return result;
+}
+
+void ResultTree::clear() {
+  m_nodes.clear();
+  m_leaves.clear();
+  m_currentPath.clear();
+}
+
+}}
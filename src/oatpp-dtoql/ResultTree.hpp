@@ -0,0 +1,85 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_ResultTree_hpp
+#define oatpp_dtoql_ResultTree_hpp
+
+#include "./Traverser.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Query result stored as a tree of shared prefixes. <br>
+ * Each node holds one field and the index of its parent node, rows are paths from the root to the leaves.
+ * A prefix shared by many rows is stored once. <br>
+ * Fill by passing to &l:Executor::execute (); as a visitor.
+ */
+class ResultTree : public Executor::RowVisitor {
+public:
+
+  struct Node {
+    v_int32 parent;
+    v_int32 level;
+    Traverser::Field field;
+  };
+
+private:
+  std::vector<Node> m_nodes;
+  std::vector<v_int32> m_leaves;
+  std::vector<v_int32> m_currentPath;
+public:
+
+  Action onRow(const Executor::Row& row) override;
+
+  const std::vector<Node>& getNodes() const;
+
+  /**
+   * Get leaf nodes in row order.
+   * @return - indexes in &l:ResultTree::getNodes ();.
+   */
+  const std::vector<v_int32>& getLeaves() const;
+
+  v_int32 getRowsCount() const;
+
+  /**
+   * Reconstruct row.
+   * @param index - row index.
+   * @param row - out. Fields of the row starting with the root.
+   */
+  void getRow(v_int32 index, std::vector<Traverser::Field>& row) const;
+
+  /**
+   * Convert to the table form of &l:Traverser::getResultTable ();.
+   * @return
+   */
+  std::vector<std::vector<Traverser::Field>> toTable() const;
+
+  void clear();
+
+};
+
+}}
+
+#endif // oatpp_dtoql_ResultTree_hpp
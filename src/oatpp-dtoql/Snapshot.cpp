@@ -0,0 +1,500 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Snapshot.hpp"
+
+#include "./CompiledPath.hpp"
+#include "./ValueUtils.hpp"
+
+#include "oatpp/core/data/mapping/type/List.hpp"
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/data/mapping/type/Object.hpp"
+#include "oatpp/core/data/mapping/type/Primitive.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OATPP_DTOQL_SNAPSHOT_MMAP
+#endif
+
+namespace oatpp { namespace dtoql {
+
+namespace {
+
+  const char MAGIC[8] = {'D', 'T', 'O', 'Q', 'L', 'S', 'N', '1'};
+  const v_uint64 HEADER_SIZE = 16;
+  const v_uint64 NODE_HEADER_SIZE = 8;
+  const v_uint64 ENTRY_SIZE = 24;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Node
+
+Snapshot::NodeType Snapshot::Node::getType() const {
+  if(m_offset == 0) {
+    return NULL_VALUE;
+  }
+  return (NodeType) m_snapshot->read<v_uint32>(m_offset);
+}
+
+v_int32 Snapshot::Node::getCount() const {
+  if(m_offset == 0) {
+    return 0;
+  }
+  return (v_int32) m_snapshot->read<v_uint32>(m_offset + 4);
+}
+
+bool Snapshot::Node::getBoolean() const {
+  return getType() == BOOLEAN && getCount() != 0;
+}
+
+v_int64 Snapshot::Node::getInteger() const {
+  switch(getType()) {
+    case INTEGER: return m_snapshot->read<v_int64>(m_offset + NODE_HEADER_SIZE);
+    case FLOAT: return (v_int64) m_snapshot->read<v_float64>(m_offset + NODE_HEADER_SIZE);
+    default: return 0;
+  }
+}
+
+v_float64 Snapshot::Node::getFloat() const {
+  switch(getType()) {
+    case INTEGER: return (v_float64) m_snapshot->read<v_int64>(m_offset + NODE_HEADER_SIZE);
+    case FLOAT: return m_snapshot->read<v_float64>(m_offset + NODE_HEADER_SIZE);
+    default: return 0;
+  }
+}
+
+const char* Snapshot::Node::getStringData() const {
+  if(getType() != STRING) {
+    return nullptr;
+  }
+  return m_snapshot->getData(m_offset + NODE_HEADER_SIZE, (v_uint64) getCount());
+}
+
+oatpp::String Snapshot::Node::getString() const {
+  const char* data = getStringData();
+  if(data == nullptr) {
+    return nullptr;
+  }
+  return oatpp::String(data, getCount(), true);
+}
+
+Snapshot::Node Snapshot::Node::getElement(v_int32 index) const {
+  if(getType() != LIST || index < 0 || index >= getCount()) {
+    throw std::runtime_error("[oatpp::dtoql::Snapshot::Node::getElement()]: Error. Invalid index.");
+  }
+  return Node(m_snapshot, m_snapshot->read<v_uint64>(m_offset + NODE_HEADER_SIZE + 8 * (v_uint64) index));
+}
+
+v_uint64 Snapshot::Node::getEntryOffset(v_int32 index) const {
+  auto type = getType();
+  if((type != MAP && type != OBJECT) || index < 0 || index >= getCount()) {
+    throw std::runtime_error("[oatpp::dtoql::Snapshot::Node::getEntryOffset()]: Error. Invalid entry.");
+  }
+  return m_offset + NODE_HEADER_SIZE + 8 + ENTRY_SIZE * (v_uint64) index;
+}
+
+Snapshot::Node Snapshot::Node::getKey(v_int32 index) const {
+  return Node(m_snapshot, m_snapshot->read<v_uint64>(getEntryOffset(index) + 8));
+}
+
+Snapshot::Node Snapshot::Node::getValue(v_int32 index) const {
+  return Node(m_snapshot, m_snapshot->read<v_uint64>(getEntryOffset(index) + 16));
+}
+
+v_int32 Snapshot::Node::find(const char* name, v_int32 size, v_uint64 hash) const {
+
+  auto type = getType();
+  if(type != MAP && type != OBJECT) {
+    return -1;
+  }
+
+  v_uint64 count = (v_uint64) getCount();
+  v_uint32 tableSize = m_snapshot->read<v_uint32>(m_offset + NODE_HEADER_SIZE);
+  if(tableSize == 0) {
+    return -1;
+  }
+
+  v_uint64 table = m_offset + NODE_HEADER_SIZE + 8 + ENTRY_SIZE * count;
+  v_uint32 mask = tableSize - 1;
+  v_uint32 slot = (v_uint32) hash & mask;
+
+  for(v_uint32 probe = 0; probe < tableSize; probe ++) {
+    v_uint32 entry = m_snapshot->read<v_uint32>(table + 4 * (v_uint64) slot);
+    if(entry == 0) {
+      return -1;
+    }
+    v_uint64 entryOffset = m_offset + NODE_HEADER_SIZE + 8 + ENTRY_SIZE * (v_uint64) (entry - 1);
+    if(m_snapshot->read<v_uint64>(entryOffset) == hash) {
+      Node key(m_snapshot, m_snapshot->read<v_uint64>(entryOffset + 8));
+      const char* data = key.getStringData(); // `nullptr` if a corrupt key is not a string
+      if(data != nullptr && key.getCount() == size && std::memcmp(data, name, (size_t) size) == 0) {
+        return (v_int32) (entry - 1);
+      }
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  return -1;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Writer
+
+Snapshot::Writer::Writer() {
+  m_buffer.append(MAGIC, sizeof(MAGIC));
+  putU64(0);
+}
+
+v_uint64 Snapshot::Writer::align() {
+  while(m_buffer.size() % 8 != 0) {
+    m_buffer.push_back(0);
+  }
+  return m_buffer.size();
+}
+
+void Snapshot::Writer::putU32(v_uint32 value) {
+  m_buffer.append((const char*) &value, sizeof(value));
+}
+
+void Snapshot::Writer::putU64(v_uint64 value) {
+  m_buffer.append((const char*) &value, sizeof(value));
+}
+
+v_uint64 Snapshot::Writer::writeString(const char* data, v_int32 size) {
+  v_uint64 offset = align();
+  putU32(STRING);
+  putU32((v_uint32) size);
+  m_buffer.append(data, (size_t) size);
+  return offset;
+}
+
+v_uint64 Snapshot::Writer::writeEntries(NodeType type, const std::vector<Entry>& entries) {
+
+  /* open addressing table, at most half full */
+  v_uint32 tableSize = 0;
+  if(!entries.empty()) {
+    tableSize = 2;
+    while(tableSize < entries.size() * 2) {
+      tableSize <<= 1;
+    }
+  }
+
+  std::vector<v_uint32> table(tableSize, 0);
+  for(size_t i = 0; i < entries.size(); i ++) {
+    if(entries[i].key == 0) {
+      continue;
+    }
+    v_uint32 slot = (v_uint32) entries[i].hash & (tableSize - 1);
+    while(table[slot] != 0) {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+    table[slot] = (v_uint32) i + 1;
+  }
+
+  v_uint64 offset = align();
+  putU32(type);
+  putU32((v_uint32) entries.size());
+  putU32(tableSize);
+  putU32(0);
+  for(const auto& entry : entries) {
+    putU64(entry.hash);
+    putU64(entry.key);
+    putU64(entry.value);
+  }
+  for(v_uint32 slot : table) {
+    putU32(slot);
+  }
+  return offset;
+
+}
+
+v_uint64 Snapshot::Writer::writeNode(const AbstractObjectWrapper& value) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(!value) {
+    return 0;
+  }
+
+  auto classId = value.valueType->classId.id;
+
+  v_int64 integer;
+  v_float64 number;
+  bool isInteger;
+
+  if(ValueUtils::readNumber(value, integer, number, isInteger)) {
+    v_uint64 offset = align();
+    if(isInteger) {
+      putU32(INTEGER);
+      putU32(0);
+      putU64((v_uint64) integer);
+    } else {
+      putU32(FLOAT);
+      putU32(0);
+      m_buffer.append((const char*) &number, sizeof(number));
+    }
+    return offset;
+  }
+
+  if(classId == type::__class::Boolean::CLASS_ID.id) {
+    v_uint64 offset = align();
+    putU32(BOOLEAN);
+    putU32(static_cast<type::Primitive<bool, type::__class::Boolean>*>(value.get())->getValue() ? 1 : 0);
+    return offset;
+  }
+
+  /* strings and containers referenced more than once are written once */
+
+  auto it = m_written.find(value.get());
+  if(it != m_written.end()) {
+    return it->second;
+  }
+
+  v_uint64 offset;
+
+  if(classId == type::__class::String::CLASS_ID.id) {
+
+    auto string = static_cast<oatpp::base::StrBuffer*>(value.get());
+    offset = writeString((const char*) string->getData(), string->getSize());
+
+  } else if(classId == type::__class::AbstractList::CLASS_ID.id ||
+            classId == type::__class::AbstractListMap::CLASS_ID.id ||
+            classId == type::__class::AbstractObject::CLASS_ID.id)
+  {
+
+    if(!m_inProgress.insert(value.get()).second) {
+      throw std::runtime_error("[oatpp::dtoql::Snapshot::encode()]: Error. Cyclic DTO graph.");
+    }
+
+    if(classId == type::__class::AbstractList::CLASS_ID.id) {
+
+      typedef type::List<AbstractObjectWrapper> AbstractList;
+      auto list = static_cast<AbstractList*>(value.get());
+
+      std::vector<v_uint64> elements;
+      elements.reserve((size_t) list->count());
+      auto node = list->getFirstNode();
+      while(node != nullptr) {
+        elements.push_back(writeNode(node->getData()));
+        node = node->getNext();
+      }
+
+      offset = align();
+      putU32(LIST);
+      putU32((v_uint32) elements.size());
+      for(v_uint64 element : elements) {
+        putU64(element);
+      }
+
+    } else if(classId == type::__class::AbstractListMap::CLASS_ID.id) {
+
+      typedef type::ListMap<oatpp::String, AbstractObjectWrapper> AbstractFieldsMap;
+      auto map = static_cast<AbstractFieldsMap*>(value.get());
+
+      std::vector<Entry> entries;
+      entries.reserve((size_t) map->count());
+      auto entry = map->getFirstEntry();
+      while(entry != nullptr) {
+        const auto& key = entry->getKey();
+        Entry e{0, 0, 0};
+        if(key) {
+          e.hash = CompiledPath::hash((const char*) key->getData(), key->getSize());
+          e.key = writeNode(key);
+        }
+        e.value = writeNode(entry->getValue());
+        entries.push_back(e);
+        entry = entry->getNext();
+      }
+
+      offset = writeEntries(MAP, entries);
+
+    } else {
+
+      auto object = (const v_char8*) value.get();
+      const auto& properties = value.valueType->properties->getList();
+
+      std::vector<Entry> entries;
+      entries.reserve(properties.size());
+      for(const auto& property : properties) {
+        v_int32 nameSize = (v_int32) std::strlen(property->name);
+        Entry e;
+        e.hash = CompiledPath::hash(property->name, nameSize);
+        auto name = m_written.find(property->name);
+        if(name != m_written.end()) {
+          e.key = name->second;
+        } else {
+          e.key = writeString(property->name, nameSize);
+          m_written[property->name] = e.key;
+        }
+        e.value = writeNode(*(const AbstractObjectWrapper*) (object + property->offset));
+        entries.push_back(e);
+      }
+
+      offset = writeEntries(OBJECT, entries);
+
+    }
+
+    m_inProgress.erase(value.get());
+
+  } else {
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::encode()]: Error. Unsupported type '") +
+                             value.valueType->classId.name + "'.");
+  }
+
+  m_written[value.get()] = offset;
+  return offset;
+
+}
+
+std::string Snapshot::Writer::finish(v_uint64 root) {
+  align();
+  std::memcpy(&m_buffer[8], &root, sizeof(root));
+  return std::move(m_buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Snapshot
+
+Snapshot::Snapshot(const void* data, v_uint64 size)
+  : m_data((const char*) data)
+  , m_size(size)
+  , m_mapping(nullptr)
+  , m_mappingSize(0)
+{
+  init();
+}
+
+Snapshot::Snapshot(std::string&& buffer)
+  : m_buffer(std::move(buffer))
+  , m_mapping(nullptr)
+  , m_mappingSize(0)
+{
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+  init();
+}
+
+Snapshot::~Snapshot() {
+#ifdef OATPP_DTOQL_SNAPSHOT_MMAP
+  if(m_mapping != nullptr) {
+    munmap(m_mapping, (size_t) m_mappingSize);
+  }
+#endif
+}
+
+void Snapshot::init() {
+  if(m_size < HEADER_SIZE || std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("[oatpp::dtoql::Snapshot::Snapshot()]: Error. Not a snapshot.");
+  }
+  v_uint64 root = read<v_uint64>(8);
+  if(root != 0) {
+    check(root, NODE_HEADER_SIZE);
+  }
+}
+
+void Snapshot::check(v_uint64 offset, v_uint64 size) const {
+  if(offset > m_size || size > m_size - offset) {
+    throw std::runtime_error("[oatpp::dtoql::Snapshot::check()]: Error. Offset is out of snapshot bounds.");
+  }
+}
+
+std::string Snapshot::encode(const AbstractObjectWrapper& root) {
+  Writer writer;
+  v_uint64 offset = writer.writeNode(root);
+  return writer.finish(offset);
+}
+
+void Snapshot::save(const AbstractObjectWrapper& root, const char* filename) {
+  std::string data = encode(root);
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(data.data(), (std::streamsize) data.size());
+  if(!file) {
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::save()]: Error. Can't write file '") + filename + "'.");
+  }
+}
+
+std::shared_ptr<Snapshot> Snapshot::open(const char* filename) {
+
+#ifdef OATPP_DTOQL_SNAPSHOT_MMAP
+
+  int fd = ::open(filename, O_RDONLY);
+  if(fd < 0) {
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::open()]: Error. Can't open file '") + filename + "'.");
+  }
+
+  struct stat info;
+  if(fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::open()]: Error. Can't read file '") + filename + "'.");
+  }
+
+  void* mapping = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(mapping == MAP_FAILED) {
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::open()]: Error. Can't map file '") + filename + "'.");
+  }
+
+  std::shared_ptr<Snapshot> snapshot;
+  try {
+    snapshot = std::make_shared<Snapshot>(mapping, (v_uint64) info.st_size);
+  } catch(...) {
+    munmap(mapping, (size_t) info.st_size);
+    throw;
+  }
+  snapshot->m_mapping = mapping;
+  snapshot->m_mappingSize = (v_uint64) info.st_size;
+  return snapshot;
+
+#else
+
+  std::ifstream file(filename, std::ios::binary);
+  if(!file) {
+    throw std::runtime_error(std::string("[oatpp::dtoql::Snapshot::open()]: Error. Can't open file '") + filename + "'.");
+  }
+  std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return std::make_shared<Snapshot>(std::move(data));
+
+#endif
+
+}
+
+Snapshot::Node Snapshot::getRoot() const {
+  return Node(this, read<v_uint64>(8));
+}
+
+v_uint64 Snapshot::getSize() const {
+  return m_size;
+}
+
+}}
@@ -0,0 +1,220 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_Snapshot_hpp
+#define oatpp_dtoql_Snapshot_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Read-only binary image of a DTO tree, queried in place - see &l:SnapshotExecutor;. <br>
+ * Layout - 16 bytes header (magic, root offset), then nodes aligned to 8 bytes. Each node starts with `u32 type, u32 count`.
+ * Lists hold an offset table of elements - index access is O(1). Objects and maps hold an entry table
+ * (`u64 key hash, u64 key offset, u64 value offset`) in the original order followed by an open addressing table
+ * of key hashes - key lookup is O(1). Shared subtrees are written once. Offset `0` stands for `null`. <br>
+ * Integer primitives are stored as 64-bit integers, float primitives as 64-bit floats. Byte order is native.
+ */
+class Snapshot {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+public:
+
+  enum NodeType : v_uint32 {
+    NULL_VALUE = 0,
+    BOOLEAN = 1,
+    INTEGER = 2,
+    FLOAT = 3,
+    STRING = 4,
+    LIST = 5,
+    MAP = 6,
+    OBJECT = 7
+  };
+
+  /**
+   * Reference to a node of the snapshot.
+   */
+  class Node {
+  private:
+    const Snapshot* m_snapshot;
+    v_uint64 m_offset;
+  private:
+    v_uint64 getEntryOffset(v_int32 index) const;
+  public:
+
+    Node() : m_snapshot(nullptr), m_offset(0) {}
+    Node(const Snapshot* snapshot, v_uint64 offset) : m_snapshot(snapshot), m_offset(offset) {}
+
+    v_uint64 getOffset() const {
+      return m_offset;
+    }
+
+    bool isNull() const {
+      return m_offset == 0;
+    }
+
+    NodeType getType() const;
+
+    /**
+     * Get number of elements of list, entries of map or object, or size of string.
+     * @return
+     */
+    v_int32 getCount() const;
+
+    bool getBoolean() const;
+    v_int64 getInteger() const;
+    v_float64 getFloat() const;
+
+    /**
+     * Get string data. Points into the snapshot, no copy.
+     * @return
+     */
+    const char* getStringData() const;
+    oatpp::String getString() const;
+
+    Node getElement(v_int32 index) const;
+    Node getKey(v_int32 index) const;
+    Node getValue(v_int32 index) const;
+
+    /**
+     * Find entry of object or map by key.
+     * @param name - key data.
+     * @param size - key size.
+     * @param hash - key hash as returned by &l:CompiledPath::hash ();.
+     * @return - entry index or `-1`.
+     */
+    v_int32 find(const char* name, v_int32 size, v_uint64 hash) const;
+
+  };
+
+private:
+
+  class Writer {
+  private:
+    struct Entry {
+      v_uint64 hash;
+      v_uint64 key;
+      v_uint64 value;
+    };
+  private:
+    std::string m_buffer;
+    std::unordered_map<const void*, v_uint64> m_written;
+    std::unordered_set<const void*> m_inProgress;
+  private:
+    v_uint64 align();
+    void putU32(v_uint32 value);
+    void putU64(v_uint64 value);
+    v_uint64 writeString(const char* data, v_int32 size);
+    v_uint64 writeEntries(NodeType type, const std::vector<Entry>& entries);
+  public:
+    Writer();
+    v_uint64 writeNode(const AbstractObjectWrapper& value);
+    std::string finish(v_uint64 root);
+  };
+
+private:
+  const char* m_data;
+  v_uint64 m_size;
+  std::string m_buffer;
+  void* m_mapping;
+  v_uint64 m_mappingSize;
+private:
+  void check(v_uint64 offset, v_uint64 size) const;
+  void init();
+public:
+
+  template<typename T>
+  T read(v_uint64 offset) const {
+    check(offset, sizeof(T));
+    T value;
+    std::memcpy(&value, m_data + offset, sizeof(T));
+    return value;
+  }
+
+  const char* getData(v_uint64 offset, v_uint64 size) const {
+    check(offset, size);
+    return m_data + offset;
+  }
+
+public:
+
+  /**
+   * Constructor. Snapshot over memory.
+   * @param data - snapshot bytes. Not copied - must outlive the snapshot.
+   * @param size - size.
+   * @throws - `std::runtime_error` if data is not a snapshot.
+   */
+  Snapshot(const void* data, v_uint64 size);
+
+  /**
+   * Constructor. Snapshot owning its bytes.
+   * @param buffer - snapshot bytes.
+   */
+  Snapshot(std::string&& buffer);
+
+  Snapshot(const Snapshot& other) = delete;
+  Snapshot& operator=(const Snapshot& other) = delete;
+
+  ~Snapshot();
+
+  /**
+   * Encode DTO tree.
+   * @param root - root object.
+   * @return - snapshot bytes.
+   * @throws - `std::runtime_error` on cyclic graph or unsupported type.
+   */
+  static std::string encode(const AbstractObjectWrapper& root);
+
+  /**
+   * Encode DTO tree to file.
+   * @param root - root object.
+   * @param filename - file name.
+   */
+  static void save(const AbstractObjectWrapper& root, const char* filename);
+
+  /**
+   * Open snapshot file. The file is memory mapped where supported, otherwise read into memory.
+   * @param filename - file name.
+   * @return - &l:Snapshot;.
+   */
+  static std::shared_ptr<Snapshot> open(const char* filename);
+
+  Node getRoot() const;
+
+  v_uint64 getSize() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_Snapshot_hpp
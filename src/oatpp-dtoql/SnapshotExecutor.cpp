@@ -0,0 +1,285 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SnapshotExecutor.hpp"
+
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Field
+
+oatpp::String SnapshotExecutor::Field::getName() const {
+  if(name == nullptr) {
+    return nullptr;
+  }
+  return oatpp::String(name, nameSize, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Row
+
+SnapshotExecutor::Row::Row(const SnapshotExecutor* executor)
+  : m_executor(executor)
+{}
+
+v_int32 SnapshotExecutor::Row::getSize() const {
+  return (v_int32) m_executor->m_frames.size();
+}
+
+v_int32 SnapshotExecutor::Row::getChangedLevel() const {
+  return m_executor->m_changedLevel;
+}
+
+const SnapshotExecutor::Field& SnapshotExecutor::Row::operator[](v_int32 level) const {
+  const Frame& frame = m_executor->m_frames[level];
+  return m_executor->m_fields[frame.begin + frame.position - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SnapshotExecutor
+
+SnapshotExecutor::SnapshotExecutor()
+  : m_changedLevel(0)
+  , m_hasRow(false)
+{}
+
+void SnapshotExecutor::start(const std::shared_ptr<CompiledPath>& plan, const std::shared_ptr<Snapshot>& snapshot) {
+
+  for(v_int32 i = 0; i < plan->getInstructionsCount(); i ++) {
+    if(plan->getInstructions()[i].predicate >= 0) {
+      throw std::runtime_error("[oatpp::dtoql::SnapshotExecutor::start()]: Error. Filters are not supported over snapshots.");
+    }
+  }
+
+  m_plan = plan;
+  m_snapshot = snapshot;
+
+  m_fields.clear();
+  m_frames.clear();
+  m_fields.push_back(Field{nullptr, 0, 0, snapshot->getRoot()});
+  m_frames.push_back(Frame{0, 1, 0});
+  m_changedLevel = 0;
+  m_hasRow = false;
+
+}
+
+SnapshotExecutor::Field SnapshotExecutor::getEntry(const Snapshot::Node& node, v_int32 index) const {
+  auto key = node.getKey(index);
+  return Field{key.getStringData(), key.getCount(), index, node.getValue(index)};
+}
+
+void SnapshotExecutor::selectAll(const Snapshot::Node& node) {
+  v_int32 count = node.getCount();
+  if(node.getType() == Snapshot::LIST) {
+    for(v_int32 i = 0; i < count; i ++) {
+      auto element = node.getElement(i);
+      if(!element.isNull()) {
+        m_fields.push_back(Field{nullptr, 0, i, element});
+      }
+    }
+  } else {
+    for(v_int32 i = 0; i < count; i ++) {
+      m_fields.push_back(getEntry(node, i));
+    }
+  }
+}
+
+void SnapshotExecutor::selectFields(const CompiledPath::Instruction& instruction, const Snapshot::Node& node) {
+
+  bool isList = node.getType() == Snapshot::LIST;
+  auto refs = m_plan->getFields(instruction);
+  v_int32 slotsCount = m_plan->resolveIndexes(instruction, node.getCount(), m_indexes, m_refSlots);
+
+  /* same slot resolution as maps in Executor - duplicate names share a slot */
+
+  m_slots.assign(slotsCount, Field{nullptr, 0, -1, Snapshot::Node()});
+
+  for(const auto& i : m_indexes) {
+    if(isList) {
+      m_slots[i.slot] = Field{nullptr, 0, i.position, node.getElement((v_int32) i.position)};
+    } else {
+      m_slots[i.slot] = getEntry(node, (v_int32) i.position);
+    }
+  }
+
+  if(!isList && instruction.namesCount > 0) {
+    for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+      const auto& f = refs[i];
+      if(f.type == Path::FieldReference::Type::NAME && f.firstOccurrence == i) {
+        v_int32 position = node.find(f.name, f.nameSize, f.hash);
+        if(position >= 0) {
+          m_slots[m_refSlots[i]] = getEntry(node, position);
+          if(node.getType() == Snapshot::OBJECT) {
+            m_slots[m_refSlots[i]].index = -1; // same as properties selected by name in Executor
+          }
+        }
+      }
+    }
+  }
+
+  for(v_int32 i = 0; i < instruction.fieldsCount; i ++) {
+    v_int32 begin = m_refSlots[i];
+    v_int32 end = m_refSlots[i + 1];
+    if(refs[i].type == Path::FieldReference::Type::NAME) {
+      begin = m_refSlots[refs[i].firstOccurrence];
+      end = begin + 1;
+    }
+    for(v_int32 slot = begin; slot < end; slot ++) {
+      /* unresolved slot has neither name nor index - `null` values are kept for maps and objects, skipped for lists */
+      const Field& field = m_slots[slot];
+      if((field.name != nullptr || field.index >= 0) && (!isList || !field.value.isNull())) {
+        m_fields.push_back(field);
+      }
+    }
+  }
+
+}
+
+void SnapshotExecutor::selectDescendants(const Snapshot::Node& node, v_int32 maxDepth) {
+
+  /* shared subtrees are written once - offsets identify them the same way pointers do in Executor */
+
+  m_descentStack.clear();
+  m_visited.clear();
+  m_descentStack.push_back(Descent{Field{nullptr, 0, -1, node}, 0});
+
+  while(!m_descentStack.empty()) {
+
+    Descent descent = m_descentStack.back();
+    m_descentStack.pop_back();
+
+    const auto& current = descent.field.value;
+    auto type = current.getType();
+    bool container = type == Snapshot::LIST || type == Snapshot::MAP || type == Snapshot::OBJECT;
+
+    if(container && !m_visited.insert(current.getOffset())) {
+      continue;
+    }
+
+    m_fields.push_back(descent.field);
+
+    if(container && (maxDepth < 0 || descent.depth < maxDepth)) {
+      v_int32 begin = (v_int32) m_fields.size();
+      selectAll(current);
+      for(v_int32 i = (v_int32) m_fields.size() - 1; i >= begin; i --) {
+        m_descentStack.push_back(Descent{m_fields[i], descent.depth + 1});
+      }
+      m_fields.resize(begin);
+    }
+
+  }
+
+}
+
+void SnapshotExecutor::select(v_int32 level, const Snapshot::Node& node) {
+
+  auto type = node.getType();
+  const auto& instruction = m_plan->getInstructions()[level];
+
+  if(type == Snapshot::NULL_VALUE) {
+    return;
+  }
+
+  if(instruction.opcode == CompiledPath::SELECT_DESCENDANTS) {
+    selectDescendants(node, instruction.maxDepth);
+    return;
+  }
+
+  if(type != Snapshot::LIST && type != Snapshot::MAP && type != Snapshot::OBJECT) {
+    return;
+  }
+
+  if(instruction.opcode == CompiledPath::SELECT_FIELDS) {
+    selectFields(instruction, node);
+  } else {
+    selectAll(node);
+  }
+
+}
+
+bool SnapshotExecutor::next() {
+
+  v_int32 leafLevel = m_plan ? m_plan->getInstructionsCount() : 0;
+
+  if(m_hasRow) {
+    m_changedLevel = leafLevel;
+    m_hasRow = false;
+  }
+
+  while(!m_frames.empty()) {
+
+    Frame& frame = m_frames.back();
+    v_int32 level = (v_int32) m_frames.size() - 1;
+
+    if(frame.position == frame.size) {
+      m_fields.resize(frame.begin);
+      m_frames.pop_back();
+      continue;
+    }
+
+    Snapshot::Node node = m_fields[frame.begin + frame.position].value;
+    frame.position ++;
+
+    if(level < m_changedLevel) {
+      m_changedLevel = level;
+    }
+
+    if(level == leafLevel) {
+      m_hasRow = true;
+      return true;
+    }
+
+    v_int32 begin = (v_int32) m_fields.size();
+    select(level, node);
+    m_frames.push_back(Frame{begin, (v_int32) m_fields.size() - begin, 0});
+
+  }
+
+  return false;
+
+}
+
+SnapshotExecutor::Row SnapshotExecutor::getRow() const {
+  return Row(this);
+}
+
+v_int64 SnapshotExecutor::execute(const std::shared_ptr<CompiledPath>& plan, const std::shared_ptr<Snapshot>& snapshot,
+                                  const RowCallback& callback)
+{
+  SnapshotExecutor executor;
+  executor.start(plan, snapshot);
+  v_int64 count = 0;
+  while(executor.next()) {
+    count ++;
+    if(!callback(executor.getRow())) {
+      break;
+    }
+  }
+  return count;
+}
+
+}}
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_SnapshotExecutor_hpp
+#define oatpp_dtoql_SnapshotExecutor_hpp
+
+#include "./CompiledPath.hpp"
+#include "./Snapshot.hpp"
+#include "./VisitedSet.hpp"
+
+#include <functional>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Executor of &l:CompiledPath; over &l:Snapshot; - same rows as &l:Executor; over the encoded DTO, without decoding. <br>
+ * List indexes and map keys are looked up in the snapshot tables, only the selected nodes are touched. <br>
+ * Filters are not supported.
+ */
+class SnapshotExecutor {
+public:
+
+  struct Field {
+
+    /**
+     * Property name or map key. Points into the snapshot. `nullptr` for list elements.
+     */
+    const char* name;
+    v_int32 nameSize;
+
+    v_int64 index;
+    Snapshot::Node value;
+
+    /**
+     * Get name.
+     * @return - &id:oatpp::String;. `nullptr` for list elements.
+     */
+    oatpp::String getName() const;
+
+  };
+
+  /**
+   * Current row - one field per level, starting with the root. Valid until the next call to &l:SnapshotExecutor::next ();.
+   */
+  class Row {
+  private:
+    const SnapshotExecutor* m_executor;
+  public:
+
+    Row(const SnapshotExecutor* executor);
+
+    v_int32 getSize() const;
+
+    /**
+     * Lowest level whose field differs from the previous row.
+     * @return - level. `0` for the first row.
+     */
+    v_int32 getChangedLevel() const;
+
+    const Field& operator[](v_int32 level) const;
+
+  };
+
+  typedef std::function<bool (const Row&)> RowCallback;
+
+private:
+
+  struct Frame {
+    v_int32 begin;
+    v_int32 size;
+    v_int32 position;
+  };
+
+  struct Descent {
+    Field field;
+    v_int32 depth;
+  };
+
+private:
+  Field getEntry(const Snapshot::Node& node, v_int32 index) const;
+  void selectAll(const Snapshot::Node& node);
+  void selectFields(const CompiledPath::Instruction& instruction, const Snapshot::Node& node);
+  void selectDescendants(const Snapshot::Node& node, v_int32 maxDepth);
+  void select(v_int32 level, const Snapshot::Node& node);
+private:
+  std::shared_ptr<CompiledPath> m_plan;
+  std::shared_ptr<Snapshot> m_snapshot;
+  std::vector<Field> m_fields;
+  std::vector<Frame> m_frames;
+  v_int32 m_changedLevel;
+  bool m_hasRow;
+  std::vector<Field> m_slots;
+  std::vector<CompiledPath::IndexSlot> m_indexes;
+  std::vector<v_int32> m_refSlots;
+  std::vector<Descent> m_descentStack;
+  VisitedSet m_visited;
+public:
+
+  SnapshotExecutor();
+
+  SnapshotExecutor(const SnapshotExecutor& other) = delete;
+  SnapshotExecutor& operator=(const SnapshotExecutor& other) = delete;
+
+  /**
+   * Start new query.
+   * @param plan - &l:CompiledPath;.
+   * @param snapshot - &l:Snapshot;. Held by the executor until the next query.
+   * @throws - `std::runtime_error` if plan has filters.
+   */
+  void start(const std::shared_ptr<CompiledPath>& plan, const std::shared_ptr<Snapshot>& snapshot);
+
+  /**
+   * Advance to the next row.
+   * @return - `true` if there is a row.
+   * @throws - `std::runtime_error` if a visited node is out of snapshot bounds.
+   */
+  bool next();
+
+  Row getRow() const;
+
+  /**
+   * Execute query.
+   * @param plan - &l:CompiledPath;.
+   * @param snapshot - &l:Snapshot;.
+   * @param callback - called for each row. Return `false` to stop.
+   * @return - number of rows visited.
+   */
+  static v_int64 execute(const std::shared_ptr<CompiledPath>& plan, const std::shared_ptr<Snapshot>& snapshot, const RowCallback& callback);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_SnapshotExecutor_hpp
@@ -25,7 +25,7 @@
 #ifndef oatpp_dtoql_Traverser_hpp
 #define oatpp_dtoql_Traverser_hpp
 
-#include "./Path.hpp"
+#include "./Executor.hpp"
 
 #include "oatpp/core/data/mapping/type/ListMap.hpp"
 #include "oatpp/core/data/mapping/type/List.hpp"
@@ -35,8 +35,14 @@
 
 #include "oatpp/core/Types.hpp"
 
+#include <list>
+
 namespace oatpp { namespace dtoql {
 
+/**
+ * Collects rows of &l:Executor; into a table of owning fields. <br>
+ * Use &l:Executor::execute (); to stream rows without materializing them.
+ */
 class Traverser {
 public:
   typedef oatpp::data::mapping::type::Type Type;
@@ -77,49 +83,26 @@ public:
 
   };
 
-private:
-
-  class StackNode {
-  private:
-    std::list<Field> m_set;
-    Field m_currField;
-  public:
-
-    StackNode(std::list<Field>&& set);
-
-    std::list<Field> popNextSelection(const std::shared_ptr<Path::FieldCollection>& fields);
-
-    const Field& popNext();
-
-    const Field& getCurrentField();
-
-    bool isEmpty();
-  };
-
-private:
-
-  static std::list<Field> selectFieldsInList(const AbstractList::ObjectWrapper& list, const std::shared_ptr<Path::FieldCollection>& fields);
-  static std::list<Field> selectFieldsInMap(const AbstractFieldsMap::ObjectWrapper& map, const std::shared_ptr<Path::FieldCollection>& fields);
-  static std::list<Field> selectFieldsInObject(const PolymorphicWrapper<Object>& polymorph, const std::shared_ptr<Path::FieldCollection>& fields);
 public:
   static std::list<Field> selectFields(const AbstractObjectWrapper& polymorph, const std::shared_ptr<Path::FieldCollection>& fields);
 
 private:
+  static Field toField(const Executor::FieldView& view);
   void pushResult();
 private:
-  std::shared_ptr<Path> m_path;
-private:
-
-  v_int32 m_pathComponentIndex;
-  std::list<std::shared_ptr<StackNode>> m_stack;
-
-private:
-
+  Executor m_executor;
   std::vector<std::vector<Field>> m_resultTable;
 
 public:
 
   Traverser(const std::shared_ptr<Path>& path, const AbstractObjectWrapper& polymorph);
+  /**
+   * Constructor.
+   * @param plan - &l:CompiledPath;.
+   * @param polymorph - root object.
+   * @param mapIndexCache - optional &l:MapIndexCache; for large maps queried repeatedly. Not owned.
+   */
+  Traverser(const std::shared_ptr<CompiledPath>& plan, const AbstractObjectWrapper& polymorph, MapIndexCache* mapIndexCache = nullptr);
 
   bool iterate();
 
@@ -127,6 +110,13 @@ public:
 
   void printResultTable();
 
+  /**
+   * Get column of the result table holding fields bound to the named variable (`$name`).
+   * @param name - variable name without `$`.
+   * @return - column or `-1` if the path has no such variable, the name is `nullptr` or there is no plan.
+   */
+  v_int32 getBindingColumn(const oatpp::String& name) const;
+
 };
 
 }}
@@ -0,0 +1,237 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_TypedPath_hpp
+#define oatpp_dtoql_TypedPath_hpp
+
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/data/mapping/type/List.hpp"
+#include "oatpp/core/data/mapping/type/Object.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+namespace typed {
+
+/**
+ * Iteration over elements of a container type. Defined for `List<T>` and `ListMap<K, T>` (`Fields<T>`).
+ * @tparam Container - container class.
+ */
+template<class Container>
+struct Elements;
+
+template<class T>
+struct Elements<oatpp::data::mapping::type::List<T>> {
+
+  typedef T Value;
+
+  /* null elements are skipped, same as &l:Executor; does */
+  template<class F>
+  static void forEach(const oatpp::data::mapping::type::List<T>* list, F& f) {
+    auto node = list->getFirstNode();
+    while(node != nullptr) {
+      const auto& data = node->getData();
+      if(data) {
+        f(data);
+      }
+      node = node->getNext();
+    }
+  }
+
+};
+
+template<class K, class T>
+struct Elements<oatpp::data::mapping::type::ListMap<K, T>> {
+
+  typedef T Value;
+
+  template<class F>
+  static void forEach(const oatpp::data::mapping::type::ListMap<K, T>* map, F& f) {
+    auto entry = map->getFirstEntry();
+    while(entry != nullptr) {
+      f(entry->getValue());
+      entry = entry->getNext();
+    }
+  }
+
+};
+
+template<class Dto>
+class RootStep {
+public:
+  typedef typename Dto::ObjectWrapper Root;
+  typedef typename Dto::ObjectWrapper Value;
+public:
+
+  template<class F>
+  void forEach(const Root& root, F& f) const {
+    f(root);
+  }
+
+};
+
+template<class Prev, class Class, class Member>
+class FieldStep {
+public:
+  typedef typename Prev::Root Root;
+  typedef Member Value;
+private:
+  Prev m_prev;
+  Member Class::* m_member;
+public:
+
+  static_assert(std::is_base_of<Class, typename Prev::Value::ObjectType>::value,
+                "[oatpp::dtoql::typed::FieldStep]: Field doesn't belong to the DTO selected by the previous step.");
+
+  FieldStep(const Prev& prev, Member Class::* member)
+    : m_prev(prev)
+    , m_member(member)
+  {}
+
+  template<class F>
+  void forEach(const Root& root, F& f) const {
+    auto member = m_member;
+    auto step = [&f, member](const typename Prev::Value& parent) {
+      if(parent) {
+        f(static_cast<const Class*>(parent.get())->*member);
+      }
+    };
+    m_prev.forEach(root, step);
+  }
+
+};
+
+template<class Prev>
+class EachStep {
+public:
+  typedef typename Prev::Root Root;
+  typedef Elements<typename Prev::Value::ObjectType> ContainerElements;
+  typedef typename ContainerElements::Value Value;
+private:
+  Prev m_prev;
+public:
+
+  EachStep(const Prev& prev)
+    : m_prev(prev)
+  {}
+
+  template<class F>
+  void forEach(const Root& root, F& f) const {
+    auto step = [&f](const typename Prev::Value& parent) {
+      if(parent) {
+        ContainerElements::forEach(parent.get(), f);
+      }
+    };
+    m_prev.forEach(root, step);
+  }
+
+};
+
+}
+
+/**
+ * Path over DTO classes known at compile time. <br>
+ * Each step is checked against the DTO type of the previous step and evaluates to direct member access -
+ * no name lookup, no classId dispatch, no &l:CompiledPath;. <br>
+ * Same rows as the equivalent &l:Path; - `field` is `['name']`, `each` is `*` over a list or a map.
+ * Null list elements are skipped, nulls are not expanded.
+ * <pre>
+ * auto ints = oatpp::dtoql::path<DtoLevel1>().field(&DtoLevel1::child1).field(&DtoLevel2::list).each().field(&DtoLevel3::int_value);
+ * ints.forEach(dto, [](const Int32& value) { ... });
+ * </pre>
+ * @tparam Step - last step.
+ */
+template<class Step>
+class TypedPath {
+public:
+  typedef typename Step::Root Root;
+  typedef typename Step::Value Value;
+private:
+  Step m_step;
+public:
+
+  TypedPath(const Step& step)
+    : m_step(step)
+  {}
+
+  /**
+   * Select DTO field.
+   * @param member - pointer to the DTO field, e.g. `&DtoLevel1::child1`.
+   * @return - extended path.
+   */
+  template<class Class, class Member>
+  TypedPath<typed::FieldStep<Step, Class, Member>> field(Member Class::* member) const {
+    return TypedPath<typed::FieldStep<Step, Class, Member>>(typed::FieldStep<Step, Class, Member>(m_step, member));
+  }
+
+  /**
+   * Select each element of a list or each value of a map.
+   * @return - extended path.
+   */
+  TypedPath<typed::EachStep<Step>> each() const {
+    return TypedPath<typed::EachStep<Step>>(typed::EachStep<Step>(m_step));
+  }
+
+  /**
+   * Call function for each selected value in executor order.
+   * @param root - root DTO.
+   * @param f - `void (const Value&)`.
+   */
+  template<class F>
+  void forEach(const Root& root, F f) const {
+    m_step.forEach(root, f);
+  }
+
+  /**
+   * Collect selected values.
+   * @param root - root DTO.
+   * @return - values.
+   */
+  std::vector<Value> select(const Root& root) const {
+    std::vector<Value> result;
+    auto push = [&result](const Value& value) {
+      result.push_back(value);
+    };
+    m_step.forEach(root, push);
+    return result;
+  }
+
+};
+
+/**
+ * Start typed path at DTO class.
+ * @tparam Dto - DTO class of the root.
+ * @return - &l:TypedPath;.
+ */
+template<class Dto>
+TypedPath<typed::RootStep<Dto>> path() {
+  return TypedPath<typed::RootStep<Dto>>(typed::RootStep<Dto>());
+}
+
+}}
+
+#endif // oatpp_dtoql_TypedPath_hpp
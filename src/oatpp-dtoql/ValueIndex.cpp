@@ -0,0 +1,323 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ValueIndex.hpp"
+
+#include "./Executor.hpp"
+#include "./ValueUtils.hpp"
+
+#include "oatpp/core/data/mapping/type/List.hpp"
+#include "oatpp/core/data/mapping/type/ListMap.hpp"
+#include "oatpp/core/data/mapping/type/Primitive.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace oatpp { namespace dtoql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ValueIndex
+
+ValueIndex::ValueIndex(const AbstractObjectWrapper& container, const std::vector<oatpp::String>& key, bool ordered)
+  : m_container(container)
+  , m_ordered(ordered)
+{
+
+  namespace type = oatpp::data::mapping::type;
+
+  for(const auto& name : key) {
+    m_key.push_back(name->std_str());
+  }
+
+  auto classId = container ? container.valueType->classId.id : -1;
+
+  /* elements are the fields a filter over the container selects - non-null list elements and all map entries */
+
+  if(classId == type::__class::AbstractList::CLASS_ID.id) {
+
+    auto list = static_cast<type::List<AbstractObjectWrapper>*>(container.get());
+    auto node = list->getFirstNode();
+    v_int64 index = 0;
+    while(node != nullptr) {
+      if(node->getData()) {
+        add(Element{nullptr, index, &node->getData()});
+      }
+      index ++;
+      node = node->getNext();
+    }
+
+  } else if(classId == type::__class::AbstractListMap::CLASS_ID.id) {
+
+    auto map = static_cast<type::ListMap<oatpp::String, AbstractObjectWrapper>*>(container.get());
+    auto entry = map->getFirstEntry();
+    v_int64 index = 0;
+    while(entry != nullptr) {
+      add(Element{&entry->getKey(), index, &entry->getValue()});
+      index ++;
+      entry = entry->getNext();
+    }
+
+  } else {
+    throw std::runtime_error("[oatpp::dtoql::ValueIndex::ValueIndex()]: Error. Container is not a List or Fields map.");
+  }
+
+  if(m_ordered) {
+    std::sort(m_sortedNumbers.begin(), m_sortedNumbers.end());
+    for(const auto& pair : m_strings) {
+      for(v_int32 position : pair.second) {
+        m_sortedStrings.push_back({&pair.first, position});
+      }
+    }
+    std::sort(m_sortedStrings.begin(), m_sortedStrings.end(),
+              [](const std::pair<const std::string*, v_int32>& a, const std::pair<const std::string*, v_int32>& b) {
+      return *a.first < *b.first;
+    });
+  }
+
+}
+
+void ValueIndex::add(const Element& element) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  v_int32 position = (v_int32) m_elements.size();
+  m_elements.push_back(element);
+
+  auto value = Predicate::resolve(element.value, m_key);
+  if(value == nullptr || !*value) {
+    return;
+  }
+
+  v_int64 integer;
+  v_float64 number;
+  bool isInteger;
+
+  if(ValueUtils::readNumber(*value, integer, number, isInteger)) {
+    if(std::isnan(number)) {
+      return; // equals nothing
+    }
+    if(number == 0) {
+      number = 0; // -0.0
+    }
+    m_numbers[number].push_back(position);
+    if(m_ordered) {
+      m_sortedNumbers.push_back({number, position});
+    }
+  } else if(value->valueType->classId.id == type::__class::String::CLASS_ID.id) {
+    auto str = static_cast<oatpp::base::StrBuffer*>(value->get());
+    m_strings[std::string((const char*) str->getData(), (size_t) str->getSize())].push_back(position);
+  } else if(value->valueType->classId.id == type::__class::Boolean::CLASS_ID.id) {
+    bool b = static_cast<type::Primitive<bool, type::__class::Boolean>*>(value->get())->getValue();
+    m_booleans[b ? 1 : 0].push_back(position);
+  }
+
+}
+
+void ValueIndex::lookupNumber(const Predicate::Node& comparison, std::vector<v_int32>& result) const {
+
+  /* inclusive bounds - integers beyond 2^53 share a key, exact comparison is left to the predicate */
+
+  v_float64 literal = comparison.number;
+  if(std::isnan(literal)) {
+    return;
+  }
+
+  std::vector<std::pair<v_float64, v_int32>>::const_iterator begin, end;
+  if(comparison.op == Path::Expression::LT || comparison.op == Path::Expression::LE) {
+    begin = m_sortedNumbers.begin();
+    end = std::upper_bound(m_sortedNumbers.begin(), m_sortedNumbers.end(), std::make_pair(literal, std::numeric_limits<v_int32>::max()));
+  } else {
+    begin = std::lower_bound(m_sortedNumbers.begin(), m_sortedNumbers.end(), std::make_pair(literal, std::numeric_limits<v_int32>::min()));
+    end = m_sortedNumbers.end();
+  }
+
+  for(auto it = begin; it != end; it ++) {
+    result.push_back(it->second);
+  }
+
+}
+
+void ValueIndex::lookupString(const Predicate::Node& comparison, std::vector<v_int32>& result) const {
+
+  const std::string& literal = comparison.string;
+  v_int32 op = comparison.op;
+
+  auto below = [&literal, op](const std::pair<const std::string*, v_int32>& pair) {
+    v_int32 c = pair.first->compare(literal);
+    return op == Path::Expression::GT ? c <= 0 : c < 0;
+  };
+
+  auto begin = m_sortedStrings.begin();
+  auto end = m_sortedStrings.end();
+  auto bound = std::partition_point(begin, end, below);
+
+  if(op == Path::Expression::LT) {
+    end = bound;
+  } else if(op == Path::Expression::LE) {
+    end = std::partition_point(bound, end, [&literal](const std::pair<const std::string*, v_int32>& pair) {
+      return pair.first->compare(literal) <= 0;
+    });
+  } else {
+    begin = bound;
+  }
+
+  for(auto it = begin; it != end; it ++) {
+    result.push_back(it->second);
+  }
+
+}
+
+bool ValueIndex::lookup(const Predicate::Node& comparison, std::vector<v_int32>& result) const {
+
+  result.clear();
+
+  if(comparison.type != Path::Expression::COMPARISON || comparison.operand != m_key) {
+    return false;
+  }
+
+  if(comparison.op == Path::Expression::EQ) {
+
+    const std::vector<v_int32>* bucket = nullptr;
+
+    switch(comparison.literalType) {
+      case Path::Literal::BOOLEAN:
+        bucket = &m_booleans[comparison.boolean ? 1 : 0];
+        break;
+      case Path::Literal::INTEGER:
+      case Path::Literal::FLOAT: {
+        auto it = m_numbers.find(comparison.number == 0 ? 0 : comparison.number);
+        bucket = it != m_numbers.end() ? &it->second : nullptr;
+        break;
+      }
+      case Path::Literal::STRING: {
+        auto it = m_strings.find(comparison.string);
+        bucket = it != m_strings.end() ? &it->second : nullptr;
+        break;
+      }
+      default:
+        return false;
+    }
+
+    if(bucket) {
+      result = *bucket;
+    }
+    return true;
+
+  }
+
+  if(!m_ordered) {
+    return false;
+  }
+
+  switch(comparison.literalType) {
+    case Path::Literal::INTEGER:
+    case Path::Literal::FLOAT:
+      lookupNumber(comparison, result);
+      break;
+    case Path::Literal::STRING:
+      lookupString(comparison, result);
+      break;
+    default:
+      return false;
+  }
+
+  std::sort(result.begin(), result.end());
+  return true;
+
+}
+
+const ValueIndex::Element& ValueIndex::getElement(v_int32 position) const {
+  return m_elements[position];
+}
+
+const ValueIndex::AbstractObjectWrapper& ValueIndex::getContainer() const {
+  return m_container;
+}
+
+const std::vector<std::string>& ValueIndex::getKey() const {
+  return m_key;
+}
+
+bool ValueIndex::isOrdered() const {
+  return m_ordered;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ValueIndexSet
+
+void ValueIndexSet::add(const std::shared_ptr<ValueIndex>& index) {
+  auto& indexes = m_indexes[index->getContainer().get()];
+  for(auto& existing : indexes) {
+    if(existing->getKey() == index->getKey()) {
+      existing = index;
+      return;
+    }
+  }
+  indexes.push_back(index);
+}
+
+v_int32 ValueIndexSet::build(const std::shared_ptr<Path>& collectionPath, const AbstractObjectWrapper& root,
+                             const std::vector<oatpp::String>& key, bool ordered)
+{
+
+  namespace type = oatpp::data::mapping::type;
+
+  v_int32 count = 0;
+  Executor::execute(collectionPath, root, [this, &key, ordered, &count](const Executor::Row& row) {
+    const auto& value = *row[row.getSize() - 1].value;
+    if(value) {
+      auto classId = value.valueType->classId.id;
+      if(classId == type::__class::AbstractList::CLASS_ID.id || classId == type::__class::AbstractListMap::CLASS_ID.id) {
+        add(std::make_shared<ValueIndex>(value, key, ordered));
+        count ++;
+      }
+    }
+    return Executor::RowVisitor::CONTINUE;
+  });
+
+  return count;
+
+}
+
+const ValueIndex* ValueIndexSet::find(const void* container, const std::vector<std::string>& key) const {
+  auto it = m_indexes.find(container);
+  if(it == m_indexes.end()) {
+    return nullptr;
+  }
+  for(const auto& index : it->second) {
+    if(index->getKey() == key) {
+      return index.get();
+    }
+  }
+  return nullptr;
+}
+
+void ValueIndexSet::clear() {
+  m_indexes.clear();
+}
+
+}}
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_ValueIndex_hpp
+#define oatpp_dtoql_ValueIndex_hpp
+
+#include "./Predicate.hpp"
+
+#include "oatpp/core/Types.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Secondary index over elements of `List` or entries of `Fields` map by the value of a key operand -
+ * e.g. elements of `['child1']['list']` by `@.int_value`. <br>
+ * Answers &l:Predicate::getIndexableComparison (); - equality by hash lookup, ranges by binary search if index is ordered.
+ * Lookup may return a superset of matches (numbers are keyed as 64-bit floats) - &l:Executor; tests candidates
+ * with the full predicate. <br>
+ * Index holds the container by strong reference and is valid as long as the container and its elements are not modified.
+ */
+class ValueIndex {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+public:
+
+  /**
+   * Indexed element - same as the field selected by a filter over the container.
+   */
+  struct Element {
+
+    /**
+     * Map key. `nullptr` for list elements.
+     */
+    const oatpp::String* key;
+
+    v_int64 index;
+    const AbstractObjectWrapper* value;
+
+  };
+
+private:
+  void add(const Element& element);
+  void lookupNumber(const Predicate::Node& comparison, std::vector<v_int32>& result) const;
+  void lookupString(const Predicate::Node& comparison, std::vector<v_int32>& result) const;
+private:
+  AbstractObjectWrapper m_container;
+  std::vector<std::string> m_key;
+  bool m_ordered;
+  std::vector<Element> m_elements;
+  std::unordered_map<v_float64, std::vector<v_int32>> m_numbers;
+  std::unordered_map<std::string, std::vector<v_int32>> m_strings;
+  std::vector<v_int32> m_booleans[2];
+  std::vector<std::pair<v_float64, v_int32>> m_sortedNumbers;
+  std::vector<std::pair<const std::string*, v_int32>> m_sortedStrings;
+public:
+
+  /**
+   * Constructor.
+   * @param container - `List` or `Fields` map.
+   * @param key - operand, relative to element, as in filter expression.
+   * @param ordered - also build sorted index for range lookups.
+   * @throws - `std::runtime_error` if container is not a list or map.
+   */
+  ValueIndex(const AbstractObjectWrapper& container, const std::vector<oatpp::String>& key, bool ordered = false);
+
+  /**
+   * Find candidate elements for comparison.
+   * @param comparison - comparison node with operand equal to the index key.
+   * @param result - out. Element positions in ascending order.
+   * @return - `false` if the index can't answer the comparison.
+   */
+  bool lookup(const Predicate::Node& comparison, std::vector<v_int32>& result) const;
+
+  const Element& getElement(v_int32 position) const;
+
+  const AbstractObjectWrapper& getContainer() const;
+
+  const std::vector<std::string>& getKey() const;
+
+  bool isOrdered() const;
+
+};
+
+/**
+ * Set of &l:ValueIndex; used by &l:Executor; - see &l:Executor::setValueIndexes ();. <br>
+ * Not thread-safe for modification. Lookups are read-only and can be shared by executors once the set is built.
+ */
+class ValueIndexSet {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+private:
+  std::unordered_map<const void*, std::vector<std::shared_ptr<ValueIndex>>> m_indexes;
+public:
+
+  void add(const std::shared_ptr<ValueIndex>& index);
+
+  /**
+   * Build index for each list or map selected by the path.
+   * @param collectionPath - path selecting containers.
+   * @param root - root object.
+   * @param key - operand, relative to element.
+   * @param ordered - also build sorted index for range lookups.
+   * @return - number of indexes built.
+   */
+  v_int32 build(const std::shared_ptr<Path>& collectionPath, const AbstractObjectWrapper& root,
+                const std::vector<oatpp::String>& key, bool ordered = false);
+
+  /**
+   * Find index of the container by key.
+   * @param container - container.
+   * @param key - operand.
+   * @return - &l:ValueIndex; or `nullptr`.
+   */
+  const ValueIndex* find(const void* container, const std::vector<std::string>& key) const;
+
+  void clear();
+
+};
+
+}}
+
+#endif // oatpp_dtoql_ValueIndex_hpp
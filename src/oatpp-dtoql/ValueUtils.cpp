@@ -0,0 +1,159 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ValueUtils.hpp"
+
+#include "./CompiledPath.hpp"
+
+#include "oatpp/core/data/mapping/type/Primitive.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace oatpp { namespace dtoql {
+
+bool ValueUtils::readNumber(const AbstractObjectWrapper& value, v_int64& integer, v_float64& number, bool& isInteger) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(!value) {
+    return false;
+  }
+
+  auto classId = value.valueType->classId.id;
+  isInteger = true;
+
+  if(classId == type::__class::Int32::CLASS_ID.id) {
+    integer = static_cast<type::Primitive<v_int32, type::__class::Int32>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int64::CLASS_ID.id) {
+    integer = static_cast<type::Primitive<v_int64, type::__class::Int64>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int16::CLASS_ID.id) {
+    integer = static_cast<type::Primitive<v_int16, type::__class::Int16>*>(value.get())->getValue();
+  } else if(classId == type::__class::Int8::CLASS_ID.id) {
+    integer = static_cast<type::Primitive<v_int8, type::__class::Int8>*>(value.get())->getValue();
+  } else if(classId == type::__class::Float64::CLASS_ID.id) {
+    number = static_cast<type::Primitive<v_float64, type::__class::Float64>*>(value.get())->getValue();
+    isInteger = false;
+    return true;
+  } else if(classId == type::__class::Float32::CLASS_ID.id) {
+    number = static_cast<type::Primitive<v_float32, type::__class::Float32>*>(value.get())->getValue();
+    isInteger = false;
+    return true;
+  } else {
+    return false;
+  }
+
+  number = (v_float64) integer;
+  return true;
+
+}
+
+bool ValueUtils::hash(const AbstractObjectWrapper& value, v_uint64& hash) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(!value) {
+    return false;
+  }
+
+  v_int64 integer;
+  v_float64 number;
+  bool isInteger;
+
+  /* numbers are hashed by their float value - equal integers and floats get the same hash */
+
+  if(readNumber(value, integer, number, isInteger)) {
+    if(std::isnan(number)) {
+      return false;
+    }
+    if(number == 0) {
+      number = 0; // -0.0
+    }
+    v_uint64 bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    hash = bits * 0x9E3779B97F4A7C15ULL;
+    return true;
+  }
+
+  auto classId = value.valueType->classId.id;
+
+  if(classId == type::__class::String::CLASS_ID.id) {
+    auto str = static_cast<oatpp::base::StrBuffer*>(value.get());
+    hash = CompiledPath::hash((const char*) str->getData(), str->getSize());
+    return true;
+  }
+
+  if(classId == type::__class::Boolean::CLASS_ID.id) {
+    hash = static_cast<type::Primitive<bool, type::__class::Boolean>*>(value.get())->getValue() ? 0x5555555555555555ULL : 0xAAAAAAAAAAAAAAAAULL;
+    return true;
+  }
+
+  return false;
+
+}
+
+bool ValueUtils::equals(const AbstractObjectWrapper& a, const AbstractObjectWrapper& b) {
+
+  namespace type = oatpp::data::mapping::type;
+
+  if(!a || !b) {
+    return false;
+  }
+
+  v_int64 integerA, integerB;
+  v_float64 numberA, numberB;
+  bool isIntegerA, isIntegerB;
+
+  if(readNumber(a, integerA, numberA, isIntegerA)) {
+    if(!readNumber(b, integerB, numberB, isIntegerB)) {
+      return false;
+    }
+    if(isIntegerA && isIntegerB) {
+      return integerA == integerB;
+    }
+    return numberA == numberB;
+  }
+
+  auto classId = a.valueType->classId.id;
+  if(classId != b.valueType->classId.id) {
+    return false;
+  }
+
+  if(classId == type::__class::String::CLASS_ID.id) {
+    auto strA = static_cast<oatpp::base::StrBuffer*>(a.get());
+    auto strB = static_cast<oatpp::base::StrBuffer*>(b.get());
+    return strA->getSize() == strB->getSize() && std::memcmp(strA->getData(), strB->getData(), strA->getSize()) == 0;
+  }
+
+  if(classId == type::__class::Boolean::CLASS_ID.id) {
+    return static_cast<type::Primitive<bool, type::__class::Boolean>*>(a.get())->getValue() ==
+           static_cast<type::Primitive<bool, type::__class::Boolean>*>(b.get())->getValue();
+  }
+
+  return false;
+
+}
+
+}}
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_ValueUtils_hpp
+#define oatpp_dtoql_ValueUtils_hpp
+
+#include "oatpp/core/data/mapping/type/Type.hpp"
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Access to values of oatpp primitives without knowing their static type.
+ */
+class ValueUtils {
+public:
+  typedef oatpp::data::mapping::type::AbstractObjectWrapper AbstractObjectWrapper;
+public:
+
+  /**
+   * Read numeric value of `Int8`, `Int16`, `Int32`, `Int64`, `Float32` or `Float64`.
+   * @param value - value.
+   * @param integer - out. Value, if it is an integer.
+   * @param number - out. Value converted to float.
+   * @param isInteger - out. Whether value is an integer.
+   * @return - `false` if value is `null` or not a number.
+   */
+  static bool readNumber(const AbstractObjectWrapper& value, v_int64& integer, v_float64& number, bool& isInteger);
+
+  /**
+   * Hash of `String`, number or `Boolean` value, consistent with &l:ValueUtils::equals ();.
+   * @param value - value.
+   * @param hash - out. Hash.
+   * @return - `false` if value is `null`, not a primitive, or NaN - such values equal nothing.
+   */
+  static bool hash(const AbstractObjectWrapper& value, v_uint64& hash);
+
+  /**
+   * Equality same as `==` in filters - integers and floats compare with each other, mismatched types are not equal.
+   * @param a
+   * @param b
+   * @return - `false` if either value is `null`.
+   */
+  static bool equals(const AbstractObjectWrapper& a, const AbstractObjectWrapper& b);
+
+};
+
+}}
+
+#endif // oatpp_dtoql_ValueUtils_hpp
@@ -0,0 +1,110 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "VisitedSet.hpp"
+
+namespace oatpp { namespace dtoql {
+
+VisitedSet::VisitedSet(v_int64 capacity)
+  : m_generation(1)
+  , m_size(0)
+{
+  v_int64 size = 8;
+  while(size < capacity) {
+    size <<= 1;
+  }
+  m_slots.resize(size, Slot{0, 0});
+}
+
+v_uint64 VisitedSet::mix(v_uint64 key) {
+  /* addresses are aligned - spread the high bits over the low ones */
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key;
+}
+
+void VisitedSet::grow() {
+
+  std::vector<Slot> slots(m_slots.size() * 2, Slot{0, 0});
+  v_uint64 mask = slots.size() - 1;
+
+  for(const auto& slot : m_slots) {
+    if(slot.generation == m_generation) {
+      v_uint64 i = mix(slot.key) & mask;
+      while(slots[i].generation == m_generation) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = slot;
+    }
+  }
+
+  m_slots.swap(slots);
+
+}
+
+bool VisitedSet::insert(v_uint64 key) {
+
+  if((m_size + 1) * 2 > (v_int64) m_slots.size()) {
+    grow();
+  }
+
+  v_uint64 mask = m_slots.size() - 1;
+  v_uint64 i = mix(key) & mask;
+
+  while(m_slots[i].generation == m_generation) {
+    if(m_slots[i].key == key) {
+      return false;
+    }
+    i = (i + 1) & mask;
+  }
+
+  m_slots[i] = Slot{key, m_generation};
+  m_size ++;
+  return true;
+
+}
+
+void VisitedSet::clear() {
+  m_size = 0;
+  m_generation ++;
+  if(m_generation == 0) {
+    /* stamps wrapped around - slots of old generations would look occupied */
+    for(auto& slot : m_slots) {
+      slot.generation = 0;
+    }
+    m_generation = 1;
+  }
+}
+
+v_int64 VisitedSet::getSize() const {
+  return m_size;
+}
+
+v_int64 VisitedSet::getCapacity() const {
+  return (v_int64) m_slots.size();
+}
+
+}}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_dtoql_VisitedSet_hpp
+#define oatpp_dtoql_VisitedSet_hpp
+
+#include "oatpp/core/base/Environment.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace oatpp { namespace dtoql {
+
+/**
+ * Open-addressing set of 64-bit keys - addresses or offsets of visited containers. <br>
+ * Slots are stamped with a generation, so &l:VisitedSet::clear (); is constant time and a set reused
+ * across calls stops allocating once it has grown to the largest walk.
+ */
+class VisitedSet {
+private:
+
+  struct Slot {
+    v_uint64 key;
+    v_uint32 generation;
+  };
+
+private:
+  static v_uint64 mix(v_uint64 key);
+private:
+  void grow();
+private:
+  std::vector<Slot> m_slots;
+  v_uint32 m_generation;
+  v_int64 m_size;
+public:
+
+  /**
+   * Constructor.
+   * @param capacity - initial number of slots. Rounded up to a power of two.
+   */
+  VisitedSet(v_int64 capacity = 64);
+
+  /**
+   * Insert key.
+   * @param key
+   * @return - `true` if key was not in the set.
+   */
+  bool insert(v_uint64 key);
+
+  bool insert(const void* address) {
+    return insert((v_uint64) (uintptr_t) address);
+  }
+
+  /**
+   * Remove all keys. Slots are kept for reuse.
+   */
+  void clear();
+
+  v_int64 getSize() const;
+
+  /**
+   * Number of slots.
+   * @return
+   */
+  v_int64 getCapacity() const;
+
+};
+
+}}
+
+#endif // oatpp_dtoql_VisitedSet_hpp
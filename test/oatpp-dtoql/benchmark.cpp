@@ -0,0 +1,245 @@
+
+#include "oatpp-dtoql/Executor.hpp"
+#include "oatpp-dtoql/PathParser.hpp"
+
+#include "oatpp/core/data/mapping/type/Object.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+/*
+ * Throughput benchmark of the query executor over synthetic DTOs.
+ * Usage: module-benchmark [scale] - scale multiplies sizes of generated DTOs. Default 1.
+ * Not a part of the test run. Build in release mode for meaningful numbers.
+ */
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Item : public oatpp::data::mapping::type::Object {
+
+  DTO_INIT(Item, Object)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, value);
+
+};
+
+class Wide : public oatpp::data::mapping::type::Object {
+
+  DTO_INIT(Wide, Object)
+
+  DTO_FIELD(Int32, f0);
+  DTO_FIELD(Int32, f1);
+  DTO_FIELD(Int32, f2);
+  DTO_FIELD(Int32, f3);
+  DTO_FIELD(Int32, f4);
+  DTO_FIELD(Int32, f5);
+  DTO_FIELD(Int32, f6);
+  DTO_FIELD(Int32, f7);
+  DTO_FIELD(Int32, f8);
+  DTO_FIELD(Int32, f9);
+  DTO_FIELD(Int32, f10);
+  DTO_FIELD(Int32, f11);
+  DTO_FIELD(Int32, f12);
+  DTO_FIELD(Int32, f13);
+  DTO_FIELD(Int32, f14);
+  DTO_FIELD(Int32, f15);
+
+};
+
+class Root : public oatpp::data::mapping::type::Object {
+
+  DTO_INIT(Root, Object)
+
+  DTO_FIELD(List<Wide::ObjectWrapper>::ObjectWrapper, wide);
+  DTO_FIELD(List<Item::ObjectWrapper>::ObjectWrapper, items);
+  DTO_FIELD(Fields<Item::ObjectWrapper>::ObjectWrapper, map);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::dtoql::Executor::AbstractObjectWrapper AbstractObjectWrapper;
+typedef oatpp::dtoql::Executor::AbstractFieldsMap AbstractFieldsMap;
+
+Item::ObjectWrapper generateItem(v_int32 i) {
+  auto item = Item::createShared();
+  item->name = "Name." + oatpp::utils::conversion::int32ToStr(i);
+  item->value = i;
+  return item;
+}
+
+/* list of objects with 16 fields */
+Root::ObjectWrapper generateWide(v_int32 objectsCount) {
+  auto root = Root::createShared();
+  root->wide = root->wide->createShared();
+  for(v_int32 i = 0; i < objectsCount; i ++) {
+    auto obj = Wide::createShared();
+    obj->f0 = i; obj->f1 = i; obj->f2 = i; obj->f3 = i; obj->f4 = i; obj->f5 = i; obj->f6 = i; obj->f7 = i;
+    obj->f8 = i; obj->f9 = i; obj->f10 = i; obj->f11 = i; obj->f12 = i; obj->f13 = i; obj->f14 = i; obj->f15 = i;
+    root->wide->pushBack(obj);
+  }
+  return root;
+}
+
+/* one long list and one large map */
+Root::ObjectWrapper generateContainers(v_int32 listSize, v_int32 mapSize) {
+  auto root = Root::createShared();
+  root->items = root->items->createShared();
+  root->map = root->map->createShared();
+  for(v_int32 i = 0; i < listSize; i ++) {
+    root->items->pushBack(generateItem(i));
+  }
+  for(v_int32 i = 0; i < mapSize; i ++) {
+    root->map->put("Key." + oatpp::utils::conversion::int32ToStr(i), generateItem(i));
+  }
+  return root;
+}
+
+/* tree of maps - keys n0 .. n{branching - 1}, items at the bottom */
+AbstractObjectWrapper generateDeep(v_int32 depth, v_int32 branching) {
+  if(depth == 0) {
+    return generateItem(0);
+  }
+  auto map = AbstractFieldsMap::createShared();
+  for(v_int32 i = 0; i < branching; i ++) {
+    map->put("n" + oatpp::utils::conversion::int32ToStr(i), generateDeep(depth - 1, branching));
+  }
+  return map;
+}
+
+v_int64 getPeakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+#endif
+  return -1;
+}
+
+class CountingVisitor : public oatpp::dtoql::Executor::RowVisitor {
+public:
+  v_int64 leaves = 0;
+  Action onRow(const oatpp::dtoql::Executor::Row& row) override {
+    leaves += row[row.getSize() - 1].index;
+    return CONTINUE;
+  }
+};
+
+void runCase(const char* name, const AbstractObjectWrapper& root, const char* pathText,
+             oatpp::dtoql::MapIndexCache* mapIndexCache = nullptr)
+{
+
+  auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(pathText));
+  oatpp::dtoql::Executor executor;
+  CountingVisitor visitor;
+
+  /* warm-up - grows executor buffers and fills plan caches */
+  executor.start(plan, root, mapIndexCache);
+  v_int64 rows = executor.run(visitor);
+
+  /* repeat for at least 200ms - cost of a query is not proportional to its rows */
+  v_int64 repetitions = 0;
+  v_int64 objectsBefore = oatpp::base::Environment::getObjectsCreated();
+  auto begin = std::chrono::steady_clock::now();
+  auto end = begin;
+
+  do {
+    executor.start(plan, root, mapIndexCache);
+    executor.run(visitor);
+    repetitions ++;
+    end = std::chrono::steady_clock::now();
+  } while(end - begin < std::chrono::milliseconds(200));
+
+  v_int64 objects = oatpp::base::Environment::getObjectsCreated() - objectsBefore;
+
+  v_float64 ns = (v_float64) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  v_float64 totalRows = (v_float64) rows * repetitions;
+  v_float64 nsPerRow = totalRows > 0 ? ns / totalRows : 0;
+  v_float64 rowsPerSecond = ns > 0 ? totalRows * 1e9 / ns : 0;
+
+  std::cout << std::left << std::setw(18) << name
+            << std::setw(56) << pathText
+            << std::right << std::setw(10) << rows
+            << std::setw(12) << std::fixed << std::setprecision(2) << nsPerRow
+            << std::setw(14) << std::setprecision(0) << rowsPerSecond
+            << std::setw(14) << std::setprecision(2) << (v_float64) objects / repetitions
+            << std::endl;
+
+}
+
+void runBenchmarks(v_int32 scale) {
+
+  std::cout << std::left << std::setw(18) << "case"
+            << std::setw(56) << "path"
+            << std::right << std::setw(10) << "rows"
+            << std::setw(12) << "ns/row"
+            << std::setw(14) << "rows/s"
+            << std::setw(14) << "objects/query"
+            << std::endl;
+
+  {
+    auto root = generateWide(10000 * scale);
+    runCase("wide.names", root, "['wide']*['f3', 'f7', 'f11']");
+    runCase("wide.indexes", root, "['wide']*[0, 7, -1]");
+    runCase("wide.variable", root, "['wide']**");
+  }
+
+  {
+    auto root = generateContainers(100000 * scale, 10000 * scale);
+    oatpp::dtoql::MapIndexCache mapIndexCache(256, 1);
+    runCase("list.index", root, "['items'][0, 500, -1]['value']");
+    runCase("list.slice", root, "['items'][0:1000:2]['value']");
+    runCase("list.variable", root, "['items']*['value']");
+    runCase("map.name", root, "['map']['Key.1', 'Key.500', 'Key.9999']['value']");
+    runCase("map.name.indexed", root, "['map']['Key.1', 'Key.500', 'Key.9999']['value']", &mapIndexCache);
+    runCase("map.variable", root, "['map']*['value']");
+    runCase("mixed", root, "['items', 'map'][0:10, 'Key.3', -1]['value', 'name']");
+  }
+
+  {
+    auto root = generateDeep(6, 6 + (scale - 1));
+    runCase("deep.variable", root, "******['value']");
+    runCase("deep.names", root, "['n0', 'n1']*['n2']*['n0', 'n3']*['name', 'value']");
+  }
+
+  std::cout << "\npeak memory (KB) = " << getPeakMemory() << "\n";
+
+}
+
+}
+
+int main(int argc, char* argv[]) {
+
+  oatpp::base::Environment::init();
+
+  v_int32 scale = 1;
+  if(argc > 1) {
+    scale = std::atoi(argv[1]);
+    if(scale < 1) {
+      scale = 1;
+    }
+  }
+
+  runBenchmarks(scale);
+
+  /* objects/query is 0 if object counting is disabled with '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' */
+  oatpp::base::Environment::destroy();
+
+  return 0;
+}
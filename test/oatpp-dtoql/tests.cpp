@@ -1,15 +1,40 @@
 
 #include "oatpp-test/UnitTest.hpp"
 
+#include "oatpp-dtoql/QueryCache.hpp"
+#include "oatpp-dtoql/QuerySet.hpp"
+#include "oatpp-dtoql/QueryCoroutine.hpp"
+#include "oatpp-dtoql/PathParser.hpp"
+#include "oatpp-dtoql/Aggregator.hpp"
+#include "oatpp-dtoql/BatchExecutor.hpp"
+#include "oatpp-dtoql/Executor.hpp"
+#include "oatpp-dtoql/Join.hpp"
+#include "oatpp-dtoql/JsonExecutor.hpp"
+#include "oatpp-dtoql/JsonResultWriter.hpp"
+#include "oatpp-dtoql/Mutator.hpp"
+#include "oatpp-dtoql/ParallelExecutor.hpp"
+#include "oatpp-dtoql/ResultTree.hpp"
+#include "oatpp-dtoql/SnapshotExecutor.hpp"
 #include "oatpp-dtoql/Traverser.hpp"
+#include "oatpp-dtoql/TypedPath.hpp"
+#include "oatpp-dtoql/ValueIndex.hpp"
+#include "oatpp-dtoql/ValueUtils.hpp"
+#include "oatpp-dtoql/VisitedSet.hpp"
 
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
 
+#include "oatpp/core/async/Executor.hpp"
 #include "oatpp/core/data/mapping/type/Object.hpp"
+#include "oatpp/core/data/stream/BufferStream.hpp"
 #include "oatpp/core/utils/ConversionUtils.hpp"
 #include "oatpp/core/macro/codegen.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <mutex>
 
 namespace {
 
@@ -105,6 +130,1078 @@ public:
 
       auto str = path.toString();
       OATPP_LOGD("path", "\"%s\"", str->getData());
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(std::make_shared<oatpp::dtoql::Path>(path));
+      OATPP_ASSERT(plan->getInstructionsCount() == 3);
+      OATPP_ASSERT(plan->getInstructions()[1].opcode == oatpp::dtoql::CompiledPath::SELECT_ALL);
+      OATPP_ASSERT(plan->getInstructions()[2].fieldsCount == 3);
+      OATPP_ASSERT(plan->getInstructions()[2].sortedIndexesCount == 1);
+    }
+
+    {
+
+      oatpp::String text = ".['phoneNumbers']/*.['type', 'number', 12]/$var['it\\'s', -1]";
+      auto path = oatpp::dtoql::PathParser::parse(text);
+      OATPP_ASSERT(path->toString() == text);
+
+      /* field selector followed by a dot must not read back as a descent */
+      auto dots = oatpp::dtoql::Path::Builder().fields({"a"}).selectFields().descendants().selectFields().selectFields().descendants(1).buildShared();
+      OATPP_ASSERT(dots->toString() == "['a']. ... . ..{1}");
+      auto parsedDots = oatpp::dtoql::PathParser::parse(dots->toString());
+      OATPP_ASSERT(parsedDots->toString() == dots->toString());
+      OATPP_ASSERT(parsedDots->getComponents().size() == dots->getComponents().size());
+      for(v_int32 i = 0; i < dots->getComponents().size(); i ++) {
+        OATPP_ASSERT(parsedDots->getComponents()[i]->getType() == dots->getComponents()[i]->getType());
+      }
+
+      bool thrown = false;
+      try {
+        oatpp::dtoql::PathParser::parse("*['unterminated]");
+      } catch (std::runtime_error& e) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown);
+
+      oatpp::dtoql::QueryCache cache(2);
+      auto plan = cache.get("*['list', 'map']*");
+      OATPP_ASSERT(plan->getInstructionsCount() == 3);
+      OATPP_ASSERT(cache.get("*['list', 'map']*") == plan);
+      cache.get("*");
+      cache.get("['child1']");
+      OATPP_ASSERT(cache.getSize() == 2);
+      OATPP_ASSERT(cache.get("*['list', 'map']*") != plan);
+
+    }
+
+    {
+
+      auto map = oatpp::data::mapping::type::ListMap<oatpp::String, DtoLevel3::ObjectWrapper>::createShared();
+      for(v_int32 i = 0; i < 300; i ++) {
+        auto obj = DtoLevel3::createShared();
+        obj->int_value = i;
+        map->put("Key." + oatpp::utils::conversion::int32ToStr(i), obj);
+      }
+
+      auto path = oatpp::dtoql::Path::Builder()
+        .fields({"Key.5", "Key.250", 3, "Key.5", "Key.none"})
+        .buildShared();
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(path);
+      oatpp::dtoql::MapIndexCache mapIndexCache(256, 2);
+
+      for(v_int32 i = 0; i < 3; i ++) {
+
+        oatpp::dtoql::Traverser traverser(plan, map, &mapIndexCache);
+        while(traverser.iterate()) {}
+
+        const auto& table = traverser.getResultTable();
+        OATPP_ASSERT(table.size() == 4);
+        OATPP_ASSERT(table[0][1].getName() == "Key.5" && table[0][1].getIndex() == 5);
+        OATPP_ASSERT(table[1][1].getName() == "Key.250" && table[1][1].getIndex() == 250);
+        OATPP_ASSERT(table[2][1].getName() == "Key.3" && table[2][1].getIndex() == 3);
+        OATPP_ASSERT(table[3][1].getName() == "Key.5" && table[3][1].getIndex() == 5);
+
+      }
+
+    }
+
+    {
+
+      auto path = oatpp::dtoql::PathParser::parse("['child1']['list'][-1, 0:3, 8:2:-3, 100, :-8]['int_value']");
+      OATPP_ASSERT(path->toString() == "['child1']['list'][-1, 0:3, 8:2:-3, 100, :-8]['int_value']");
+
+      oatpp::dtoql::Traverser traverser(path, createTestDto());
+      while(traverser.iterate()) {}
+
+      const auto& table = traverser.getResultTable();
+      v_int64 expected[] = {9, 0, 1, 2, 8, 5, 0, 1};
+      OATPP_ASSERT(table.size() == 8);
+      for(v_int32 i = 0; i < 8; i ++) {
+        OATPP_ASSERT(table[i][3].getIndex() == expected[i]);
+      }
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list', 'map']*['int_value']"));
+      auto dto = createTestDto();
+
+      oatpp::dtoql::Executor executor(1024);
+      v_int32 chunksCount = 0;
+
+      for(v_int32 i = 0; i < 3; i ++) {
+
+        executor.start(plan, dto);
+
+        v_int32 rowsCount = 0;
+        while(executor.next()) {
+          auto row = executor.getRow();
+          OATPP_ASSERT(row.getSize() == 5);
+          OATPP_ASSERT(row[4].getName() == "int_value");
+          rowsCount ++;
+        }
+
+        OATPP_ASSERT(rowsCount == 40);
+        if(i == 0) {
+          chunksCount = executor.getArena().getChunksCount();
+        }
+        OATPP_ASSERT(executor.getArena().getChunksCount() == chunksCount);
+
+      }
+
+    }
+
+    {
+
+      auto path = oatpp::dtoql::PathParser::parse("['child2']['list']*['int_value']");
+
+      v_int64 sum = 0;
+      auto count = oatpp::dtoql::Executor::execute(path, createTestDto(), [&sum](const oatpp::dtoql::Executor::Row& row) {
+        sum += row[3].index;
+        return row[3].index < 2 ? oatpp::dtoql::Executor::RowVisitor::CONTINUE : oatpp::dtoql::Executor::RowVisitor::STOP;
+      });
+
+      OATPP_ASSERT(count == 3);
+      OATPP_ASSERT(sum == 0 + 1 + 2);
+
+    }
+
+    {
+
+      auto path = oatpp::dtoql::PathParser::parse("*['list', 'map']*");
+      auto dto = createTestDto();
+
+      oatpp::dtoql::ResultTree tree;
+      oatpp::dtoql::Executor::execute(path, dto, tree);
+
+      oatpp::dtoql::Traverser traverser(path, dto);
+      while(traverser.iterate()) {}
+      const auto& expected = traverser.getResultTable();
+
+      OATPP_ASSERT(tree.getRowsCount() == 40);
+      OATPP_ASSERT(tree.getNodes().size() == 1 + 2 + 4 + 40);
+
+      auto table = tree.toTable();
+      OATPP_ASSERT(table.size() == expected.size());
+      for(v_int32 i = 0; i < table.size(); i ++) {
+        OATPP_ASSERT(table[i].size() == 4);
+        for(v_int32 j = 0; j < 4; j ++) {
+          OATPP_ASSERT(table[i][j].getName() == expected[i][j].getName());
+          OATPP_ASSERT(table[i][j].getIndex() == expected[i][j].getIndex());
+          OATPP_ASSERT(table[i][j].getValue().get() == expected[i][j].getValue().get());
+        }
+      }
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list', 'map'][1:, 0]['int_value', 'str_value']"));
+      auto dto = createTestDto();
+
+      oatpp::dtoql::Traverser traverser(plan, dto);
+      while(traverser.iterate()) {}
+      const auto& expected = traverser.getResultTable();
+
+      oatpp::dtoql::ParallelExecutor executor(4, 2);
+
+      for(v_int32 i = 0; i < 3; i ++) {
+        auto table = executor.execute(plan, dto);
+        OATPP_ASSERT(table.size() == 80);
+        OATPP_ASSERT(table.size() == expected.size());
+        for(v_int32 r = 0; r < table.size(); r ++) {
+          OATPP_ASSERT(table[r].size() == expected[r].size());
+          for(v_int32 c = 0; c < table[r].size(); c ++) {
+            OATPP_ASSERT(table[r][c].getIndex() == expected[r][c].getIndex());
+            OATPP_ASSERT(table[r][c].getValue().get() == expected[r][c].getValue().get());
+          }
+        }
+      }
+
+
+      /* narrow prefix over a wide list - the list is split although the levels above select one field */
+      auto wide = createTestDto();
+      for(v_int32 i = 0; i < 1000; i ++) {
+        auto obj = DtoLevel3::createShared();
+        obj->int_value = i;
+        wide->child1->list->pushBack(obj);
+      }
+      auto narrowPlan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list']*['int_value']"));
+      oatpp::dtoql::ParallelExecutor narrowExecutor(4, 16);
+      auto table = narrowExecutor.execute(narrowPlan, wide);
+      OATPP_ASSERT(narrowExecutor.getTasksCount() > 1);
+      OATPP_ASSERT(table.size() == 1010);
+      for(v_int32 r = 0; r < table.size(); r ++) {
+        OATPP_ASSERT(table[r].size() == 5 && table[r][3].getIndex() == r);
+      }
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list', 'map']*['int_value']"));
+      auto dto = createTestDto();
+
+      oatpp::dtoql::Traverser traverser(plan, dto);
+      while(traverser.iterate()) {}
+      const auto& expected = traverser.getResultTable();
+
+      oatpp::dtoql::Executor executor(plan, dto);
+
+      v_int32 rowsCount = 0;
+      v_int32 yieldsCount = 0;
+      bool finished = false;
+
+      while(!finished) {
+        v_int64 budget = 3;
+        switch(executor.advance(budget)) {
+          case oatpp::dtoql::Executor::ROW:
+            OATPP_ASSERT(executor.getRow()[3].index == expected[rowsCount][3].getIndex());
+            rowsCount ++;
+            break;
+          case oatpp::dtoql::Executor::YIELD:
+            yieldsCount ++;
+            break;
+          case oatpp::dtoql::Executor::FINISHED:
+            finished = true;
+            break;
+        }
+      }
+
+      OATPP_ASSERT(rowsCount == expected.size());
+      OATPP_ASSERT(yieldsCount > 0);
+
+    }
+
+    {
+
+      const char* queries[] = {
+        "*['list', 'map']*['int_value']",
+        "*['list', 'map']*['str_value', 'int_value']",
+        "$obj['list', 'map'][0]",
+        "*['map']"
+      };
+
+      auto dto = createTestDto();
+      oatpp::dtoql::QuerySet querySet;
+
+      for(v_int32 i = 0; i < 4; i ++) {
+        OATPP_ASSERT(querySet.add(oatpp::dtoql::PathParser::parse(queries[i])) == i);
+      }
+      OATPP_ASSERT(querySet.getSelectionsCount() == 7);
+
+      /* recursive descent is a selection of its own - depth limits are kept apart */
+      oatpp::dtoql::QuerySet descents;
+      const char* descentQueries[] = {"..['int_value']", "..{3}['int_value']", "['child1']..{1}"};
+      for(v_int32 i = 0; i < 3; i ++) {
+        descents.add(oatpp::dtoql::PathParser::parse(descentQueries[i]));
+      }
+      std::vector<std::vector<v_int64>> descentResults(3);
+      descents.execute(dto, [&descentResults](v_int32 queryId, const oatpp::dtoql::Executor::Row& row) {
+        descentResults[queryId].push_back(row[row.getSize() - 1].index);
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      });
+      for(v_int32 i = 0; i < 3; i ++) {
+        std::vector<v_int64> expected;
+        oatpp::dtoql::Executor::execute(oatpp::dtoql::PathParser::parse(descentQueries[i]), dto, [&expected](const oatpp::dtoql::Executor::Row& row) {
+          expected.push_back(row[row.getSize() - 1].index);
+          return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+        });
+        OATPP_ASSERT(!expected.empty());
+        OATPP_ASSERT(descentResults[i] == expected);
+      }
+
+      /* variables are bound per query - the same name in different queries is not a conflict */
+      oatpp::dtoql::QuerySet variables;
+      OATPP_ASSERT(variables.add(oatpp::dtoql::PathParser::parse("$a['list']")) == 0);
+      OATPP_ASSERT(variables.add(oatpp::dtoql::PathParser::parse("['child2']$a")) == 1);
+      OATPP_ASSERT(variables.execute(dto, [](v_int32 queryId, const oatpp::dtoql::Executor::Row& row) {
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      }) == 4);
+
+      std::vector<std::vector<v_int64>> results(4);
+      querySet.execute(dto, [&results](v_int32 queryId, const oatpp::dtoql::Executor::Row& row) {
+        results[queryId].push_back(row[row.getSize() - 1].index);
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      });
+
+      for(v_int32 i = 0; i < 4; i ++) {
+        oatpp::dtoql::Traverser traverser(oatpp::dtoql::PathParser::parse(queries[i]), dto);
+        while(traverser.iterate()) {}
+        const auto& table = traverser.getResultTable();
+        OATPP_ASSERT(results[i].size() == table.size());
+        for(v_int32 r = 0; r < table.size(); r ++) {
+          OATPP_ASSERT(results[i][r] == table[r].back().getIndex());
+        }
+      }
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list'][0, -1]['int_value']"));
+
+      std::vector<DtoLevel1::ObjectWrapper> roots;
+      for(v_int32 i = 0; i < 5; i ++) {
+        roots.push_back(createTestDto());
+      }
+      roots[2] = DtoLevel1::createShared();
+
+      oatpp::dtoql::BatchExecutor executor(plan);
+      oatpp::dtoql::BatchResult result;
+      OATPP_ASSERT(executor.execute(roots.begin(), roots.end(), result) == 8);
+
+      OATPP_ASSERT(result.getRowsCount() == 8);
+      for(v_int32 i = 0; i < 8; i ++) {
+        v_int32 expectedRoot = i / 2 < 2 ? i / 2 : i / 2 + 1;
+        OATPP_ASSERT(result.getRootIndex(i) == expectedRoot);
+        OATPP_ASSERT(result.getRowSize(i) == 5);
+        OATPP_ASSERT(result.getRow(i)[0].getValue().get() == roots[expectedRoot].get());
+        OATPP_ASSERT(result.getRow(i)[3].getIndex() == (i % 2 == 0 ? 0 : 9));
+      }
+
+    }
+
+    {
+
+      auto text = "['child1']['list', 'map'][?(@.int_value >= 3 && @.int_value < 7.5 && !(@.str_value ^= 'Str.5') || @['str_value'] == 'Str.9')]";
+      auto path = oatpp::dtoql::PathParser::parse(text);
+      OATPP_ASSERT(path->toString() == "['child1']['list', 'map'][?(@.int_value >= 3 && @.int_value < 7.5 && !(@.str_value ^= 'Str.5') || @.str_value == 'Str.9')]");
+      OATPP_ASSERT(oatpp::dtoql::PathParser::parse(path->toString())->toString() == path->toString());
+
+      /* longest float literal - negative subnormal with 17 digits */
+      auto subnormal = oatpp::dtoql::PathParser::parse("[?(@.x < -1.2345678901234567e-308)]");
+      auto subnormalText = subnormal->toString();
+      OATPP_ASSERT(std::strlen((const char*) subnormalText->getData()) == subnormalText->getSize());
+      auto subnormalBack = oatpp::dtoql::PathParser::parse(subnormalText);
+      OATPP_ASSERT(subnormalBack->toString() == subnormalText);
+      auto literalOf = [](const std::shared_ptr<oatpp::dtoql::Path>& p) {
+        auto filter = std::static_pointer_cast<oatpp::dtoql::Path::Filter>(p->getComponents()[0]);
+        return filter->getExpression()->getLiteral().getFloat();
+      };
+      OATPP_ASSERT(literalOf(subnormalBack) == literalOf(subnormal) && literalOf(subnormal) < 0);
+
+      oatpp::dtoql::Traverser traverser(path, createTestDto());
+      while(traverser.iterate()) {}
+
+      const auto& table = traverser.getResultTable();
+      v_int64 expected[] = {3, 4, 6, 7, 9};
+      OATPP_ASSERT(table.size() == 10);
+      for(v_int32 i = 0; i < 10; i ++) {
+        OATPP_ASSERT(table[i][3].getIndex() == expected[i % 5]);
+      }
+
+      typedef oatpp::dtoql::Path::Expression Expression;
+      auto built = oatpp::dtoql::Path::Builder()
+        .variable(nullptr)
+        .fields({"list"})
+        .filter(Expression::anyOf({
+          Expression::compare({"bool_value"}, Expression::EQ, false),
+          Expression::exists({"missing"})
+        }))
+        .buildShared();
+
+      v_int64 count = oatpp::dtoql::Executor::execute(built, createTestDto(), [](const oatpp::dtoql::Executor::Row& row) {
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      });
+      OATPP_ASSERT(count == 10);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+
+      {
+        oatpp::data::stream::BufferOutputStream stream;
+        auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list'][0:3]['int_value', 'str_value']"));
+        oatpp::dtoql::JsonResultWriter::write(&stream, plan, dto);
+        OATPP_ASSERT(stream.toString() == "[0,\"Str.0\",1,\"Str.1\",2,\"Str.2\"]");
+      }
+
+      {
+        oatpp::data::stream::BufferOutputStream stream;
+        auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list', 'map'][0, 'Key.1']['str_value']"));
+        oatpp::dtoql::JsonResultWriter::write(&stream, plan, dto, oatpp::dtoql::JsonResultWriter::NESTED);
+        OATPP_ASSERT(stream.toString() == "{\"child1\":{\"list\":[{\"str_value\":\"Str.0\"}],"
+                                          "\"map\":{\"Key.0\":{\"str_value\":\"Str.0\"},\"Key.1\":{\"str_value\":\"Str.1\"}}}}");
+      }
+
+      {
+        /* descendants mix list elements and map entries - written as entries */
+        auto child = DtoLevel2::createShared();
+        child->list = child->list->createShared();
+        child->map = child->map->createShared();
+        auto element = DtoLevel3::createShared();
+        element->int_value = 1;
+        child->list->pushBack(element);
+        auto entry = DtoLevel3::createShared();
+        entry->int_value = 2;
+        child->map->put("list", entry);
+        dto->child2 = child;
+
+        oatpp::data::stream::BufferOutputStream stream;
+        auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child2']..['int_value']"));
+        oatpp::dtoql::JsonResultWriter::write(&stream, plan, dto, oatpp::dtoql::JsonResultWriter::NESTED);
+        OATPP_ASSERT(stream.toString() == "{\"child2\":[{\"index\":0,\"value\":{\"int_value\":1}},"
+                                          "{\"name\":\"list\",\"value\":{\"int_value\":2}}]}");
+
+        oatpp::data::stream::BufferOutputStream rootStream;
+        plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("..{0}['child2']['list'][0]['int_value']"));
+        oatpp::dtoql::JsonResultWriter::write(&rootStream, plan, dto, oatpp::dtoql::JsonResultWriter::NESTED);
+        OATPP_ASSERT(rootStream.toString() == "[{\"value\":{\"child2\":{\"list\":[{\"int_value\":1}]}}}]");
+      }
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list']*['int_value', 'str_value']"));
+      auto dto = createTestDto();
+
+      std::vector<oatpp::dtoql::Aggregator::Result> groups;
+      std::vector<oatpp::String> names;
+      auto total = oatpp::dtoql::Aggregator::aggregate(plan, dto, 1,
+        [&groups, &names, &dto](const oatpp::dtoql::Executor::FieldView* group, v_int32 size, const oatpp::dtoql::Aggregator::Result& result) {
+          OATPP_ASSERT(group[0].value->get() == dto.get()); // the last group is reported after the rows
+          names.push_back(group[size - 1].getName());
+          groups.push_back(result);
+        });
+
+      OATPP_ASSERT(total.count == 40);
+      OATPP_ASSERT(total.numbersCount == 20);
+      OATPP_ASSERT(total.isInteger && total.integerSum == 45 + 10045);
+      OATPP_ASSERT(total.min == 0 && total.max == 1009);
+
+      OATPP_ASSERT(groups.size() == 2);
+      OATPP_ASSERT(names[0] == "child1" && names[1] == "child2");
+      OATPP_ASSERT(groups[0].integerSum == 45 && groups[0].count == 20);
+      OATPP_ASSERT(groups[1].getAverage() == 1004.5);
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list']*['int_value']"));
+      auto dto = createTestDto();
+
+      std::vector<const oatpp::dtoql::Executor::AbstractObjectWrapper*> all;
+      oatpp::dtoql::Executor::execute(plan, dto, [&all](const oatpp::dtoql::Executor::Row& row) {
+        all.push_back(row[row.getSize() - 1].value);
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      });
+      OATPP_ASSERT(all.size() == 20);
+
+      std::vector<const oatpp::dtoql::Executor::AbstractObjectWrapper*> pages;
+      oatpp::dtoql::Executor::RowCallback collect = [&pages](const oatpp::dtoql::Executor::Row& row) {
+        pages.push_back(row[row.getSize() - 1].value);
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      };
+
+      oatpp::String token = "";
+      std::vector<v_int64> sizes;
+      while(true) {
+        auto cursor = oatpp::dtoql::Cursor::parse(token);
+        oatpp::dtoql::Executor executor;
+        executor.start(plan, dto, cursor);
+        v_int64 count = 0;
+        while(count < 7 && executor.next()) {
+          collect(executor.getRow());
+          count ++;
+        }
+        sizes.push_back(count);
+        if(count < 7) {
+          break;
+        }
+        token = executor.getCursor().toString();
+      }
+
+      OATPP_ASSERT(token == "0.1.0.3.0");
+      OATPP_ASSERT(sizes.size() == 3 && sizes[0] == 7 && sizes[1] == 7 && sizes[2] == 6);
+      OATPP_ASSERT(pages == all);
+
+      oatpp::dtoql::Cursor cursor;
+      pages.clear();
+
+      struct Visitor : public oatpp::dtoql::Executor::RowVisitor {
+        std::vector<const oatpp::dtoql::Executor::AbstractObjectWrapper*>* rows;
+        Action onRow(const oatpp::dtoql::Executor::Row& row) override {
+          rows->push_back(row[row.getSize() - 1].value);
+          return CONTINUE;
+        }
+      } visitor;
+      visitor.rows = &pages;
+
+      OATPP_ASSERT(oatpp::dtoql::Executor::executePage(plan, dto, cursor, 5, 3, visitor) == 3);
+      OATPP_ASSERT(cursor.toString() == "0.0.0.7.0");
+      OATPP_ASSERT(oatpp::dtoql::Executor::executePage(plan, dto, cursor, 0, 3, visitor) == 3);
+      OATPP_ASSERT(pages.size() == 6 && pages[0] == all[5] && pages[5] == all[10]);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+
+      auto ints = oatpp::dtoql::path<DtoLevel1>().field(&DtoLevel1::child2).field(&DtoLevel2::map).each().field(&DtoLevel3::int_value);
+      auto values = ints.select(dto);
+
+      std::vector<const oatpp::dtoql::Executor::AbstractObjectWrapper*> expected;
+      oatpp::dtoql::Executor::execute(oatpp::dtoql::PathParser::parse("['child2']['map']*['int_value']"), dto,
+        [&expected](const oatpp::dtoql::Executor::Row& row) {
+          expected.push_back(row[row.getSize() - 1].value);
+          return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+        });
+
+      OATPP_ASSERT(values.size() == 10 && expected.size() == 10);
+      for(v_int32 i = 0; i < 10; i ++) {
+        OATPP_ASSERT(values[i].get() == expected[i]->get());
+      }
+
+      v_int32 count = 0;
+      oatpp::dtoql::path<DtoLevel1>().field(&DtoLevel1::child1).field(&DtoLevel2::list).each()
+        .forEach(dto, [&count](const DtoLevel3::ObjectWrapper& value) {
+          OATPP_ASSERT(value->int_value.get() != nullptr);
+          count ++;
+        });
+      OATPP_ASSERT(count == 10);
+
+    }
+
+    {
+
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list', 'missing'][?(@.int_value < 4)]['int_value']"));
+      auto dto = createTestDto();
+
+      oatpp::dtoql::QueryStats stats;
+      oatpp::dtoql::Executor executor;
+      executor.setStats(&stats);
+
+      for(v_int32 i = 0; i < 2; i ++) {
+        executor.start(plan, dto);
+        while(executor.next()) {}
+      }
+
+      OATPP_ASSERT(stats.getQueriesCount() == 2);
+      OATPP_ASSERT(stats.getRowsCount() == 8);
+
+      const auto& components = stats.getComponents();
+      OATPP_ASSERT(components.size() == 4);
+      OATPP_ASSERT(components[1].visits == 2 && components[1].selected == 2); // 'missing' is not found
+      OATPP_ASSERT(components[2].visits == 2 && components[2].selected == 8 && components[2].rejected == 12);
+      OATPP_ASSERT(components[3].visits == 8 && components[3].misses == 0);
+
+      auto text = stats.explain(*plan);
+      OATPP_LOGD("explain", "\n%s", text->getData());
+      OATPP_ASSERT(text->std_str().find("['child1']['list', 'missing'][?(@.int_value < 4)]['int_value']\n") != std::string::npos);
+
+      /* fields were found - rejected by filter, not missed */
+      oatpp::dtoql::QueryStats rejectedStats;
+      executor.setStats(&rejectedStats);
+      executor.start(oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list'][?(@.int_value > 100)]")), dto);
+      OATPP_ASSERT(!executor.next());
+      OATPP_ASSERT(rejectedStats.getComponentStats(2).visits == 1);
+      OATPP_ASSERT(rejectedStats.getComponentStats(2).rejected == 10);
+      OATPP_ASSERT(rejectedStats.getComponentStats(2).misses == 0);
+
+      /* stats hold the plan - another plan can not take its address while the stats refer to it */
+      std::weak_ptr<oatpp::dtoql::CompiledPath> held;
+      {
+        auto temporary = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child2']"));
+        held = temporary;
+        oatpp::dtoql::Executor temporaryExecutor;
+        temporaryExecutor.setStats(&rejectedStats);
+        temporaryExecutor.start(temporary, dto);
+        while(temporaryExecutor.next()) {}
+      }
+      OATPP_ASSERT(!held.expired());
+      OATPP_ASSERT(rejectedStats.getQueriesCount() == 1);
+      rejectedStats.reset();
+      OATPP_ASSERT(held.expired());
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+
+      auto path = oatpp::dtoql::PathParser::parse("..{3}['int_value']");
+      OATPP_ASSERT(path->toString() == "..{3}['int_value']");
+
+      /* map values are the same objects as list elements - each is visited once */
+      OATPP_ASSERT(oatpp::dtoql::Executor::execute(path, dto, [](const oatpp::dtoql::Executor::Row& row) {
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      }) == 20);
+      OATPP_ASSERT(oatpp::dtoql::Executor::execute(oatpp::dtoql::PathParser::parse("..{2}['int_value']"), dto, [](const oatpp::dtoql::Executor::Row& row) {
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      }) == 0);
+      /* filter is applied to children of each descendant - both the list and the map hold matching objects */
+      OATPP_ASSERT(oatpp::dtoql::Executor::execute(oatpp::dtoql::PathParser::parse("['child2']..[?(@.int_value >= 1005)]"), dto, [](const oatpp::dtoql::Executor::Row& row) {
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      }) == 10);
+
+      auto map = oatpp::dtoql::Executor::AbstractFieldsMap::createShared();
+      map->put("self", map);
+      map->put("value", oatpp::String("v"));
+
+      v_int32 count = 0;
+      oatpp::dtoql::Executor::execute(oatpp::dtoql::Path::Builder().descendants().buildShared(), map,
+        [&count](const oatpp::dtoql::Executor::Row& row) {
+          count ++;
+          return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+        });
+      OATPP_ASSERT(count == 2);
+
+      map->put("self", nullptr); // break the cycle
+
+    }
+
+    {
+
+      oatpp::String json =
+        "{\"child1\": {\"list\": [{\"str_value\": \"a\\\"b \\u00e9 {[\", \"int_value\": 1}, null, {\"int_value\": 2}],"
+        " \"map\": {\"k1\": {\"int_value\": 3.5}, \"k\\u0032\": {\"int_value\": 4}}}, \"child2\": null} ";
+
+      std::vector<v_float64> values;
+      auto collect = [&values](const oatpp::dtoql::JsonExecutor::Row& row) {
+        values.push_back(row[row.getSize() - 1].value.getFloat());
+        return true;
+      };
+
+      auto compile = [](const char* text) {
+        return oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(text));
+      };
+
+      OATPP_ASSERT(oatpp::dtoql::JsonExecutor::execute(compile("['child1']['list']*['int_value']"), json, collect) == 2);
+      OATPP_ASSERT(oatpp::dtoql::JsonExecutor::execute(compile("['child1']['list'][-1]['int_value']"), json, collect) == 1);
+      OATPP_ASSERT(oatpp::dtoql::JsonExecutor::execute(compile("['child1']['map']['k2', 0]['int_value']"), json, collect) == 2);
+      OATPP_ASSERT(oatpp::dtoql::JsonExecutor::execute(compile("..['int_value']"), json, collect) == 4);
+
+      v_float64 expected[] = {1, 2, 2, 4, 3.5, 1, 2, 3.5, 4};
+      OATPP_ASSERT(values.size() == 9);
+      for(v_int32 i = 0; i < 9; i ++) {
+        OATPP_ASSERT(values[i] == expected[i]);
+      }
+
+      oatpp::dtoql::JsonExecutor::execute(compile("*['list'][0]['str_value']"), json, [](const oatpp::dtoql::JsonExecutor::Row& row) {
+        OATPP_ASSERT(row[1].getName() == "child1");
+        OATPP_ASSERT(row[4].value.getString() == "a\"b \xc3\xa9 {[");
+        return true;
+      });
+
+      bool failed = false;
+      try {
+        oatpp::dtoql::JsonExecutor::execute(compile("['a']*"), "{\"a\": [1, 2}", collect);
+      } catch(const std::runtime_error& e) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+      oatpp::dtoql::Snapshot::save(dto, "dtoql-snapshot-test.bin");
+      auto snapshot = oatpp::dtoql::Snapshot::open("dtoql-snapshot-test.bin");
+      std::remove("dtoql-snapshot-test.bin");
+
+      const char* paths[] = {
+        "['child1']['list'][0, -1, 3:5]['int_value']",
+        "['child2']['map']['Key-Obj-2.3', 1, 'missing', 'Key-Obj-2.3']['str_value', 'bool_value']",
+        "*['map']*['int_value']",
+        "['child1', 1]..{1}"
+      };
+
+      /* rows over the snapshot match rows over the DTO - names, indexes and leaf values */
+
+      for(const char* text : paths) {
+
+        auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(text));
+
+        std::vector<std::string> expected;
+        oatpp::dtoql::Executor::execute(plan, dto, [&expected](const oatpp::dtoql::Executor::Row& row) {
+          std::string line;
+          for(v_int32 i = 0; i < row.getSize(); i ++) {
+            if(row[i].name) line.append(row[i].name, row[i].nameSize);
+            line += ":" + std::to_string(row[i].index) + " ";
+          }
+          const auto& value = *row[row.getSize() - 1].value;
+          v_int64 integer; v_float64 number; bool isInteger;
+          if(oatpp::dtoql::ValueUtils::readNumber(value, integer, number, isInteger)) {
+            line += std::to_string(integer);
+          } else if(value && value.valueType->classId.id == oatpp::data::mapping::type::__class::String::CLASS_ID.id) {
+            line += oatpp::data::mapping::type::static_wrapper_cast<oatpp::base::StrBuffer>(value)->std_str();
+          }
+          expected.push_back(line);
+          return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+        });
+
+        std::vector<std::string> actual;
+        oatpp::dtoql::SnapshotExecutor::execute(plan, snapshot, [&actual](const oatpp::dtoql::SnapshotExecutor::Row& row) {
+          std::string line;
+          for(v_int32 i = 0; i < row.getSize(); i ++) {
+            if(row[i].name) line.append(row[i].name, row[i].nameSize);
+            line += ":" + std::to_string(row[i].index) + " ";
+          }
+          const auto& value = row[row.getSize() - 1].value;
+          if(value.getType() == oatpp::dtoql::Snapshot::INTEGER) {
+            line += std::to_string(value.getInteger());
+          } else if(value.getType() == oatpp::dtoql::Snapshot::STRING) {
+            line += value.getString()->std_str();
+          }
+          actual.push_back(line);
+          return true;
+        });
+
+        OATPP_LOGD("snapshot", "'%s' -> %d rows", text, (v_int32) actual.size());
+        OATPP_ASSERT(!expected.empty());
+        OATPP_ASSERT(actual == expected);
+
+      }
+
+      auto root = snapshot->getRoot();
+      auto list = root.getValue(root.find("child2", 6, oatpp::dtoql::CompiledPath::hash("child2", 6))).getValue(0);
+      OATPP_ASSERT(list.getType() == oatpp::dtoql::Snapshot::LIST && list.getCount() == 10);
+      OATPP_ASSERT(list.getElement(7).getValue(1).getInteger() == 1007);
+
+      /* corrupt key - not a string, of the same size as the looked up name */
+      std::string bytes = oatpp::dtoql::Snapshot::encode(dto);
+      {
+        oatpp::dtoql::Snapshot intact(bytes.data(), bytes.size());
+        v_uint64 keyOffset = intact.getRoot().getKey(0).getOffset();
+        v_uint32 type = oatpp::dtoql::Snapshot::INTEGER;
+        std::memcpy(&bytes[keyOffset], &type, sizeof(type));
+      }
+      oatpp::dtoql::Snapshot corrupt(std::move(bytes));
+      OATPP_ASSERT(corrupt.getRoot().find("child1", 6, oatpp::dtoql::CompiledPath::hash("child1", 6)) == -1);
+      OATPP_ASSERT(corrupt.getRoot().find("child2", 6, oatpp::dtoql::CompiledPath::hash("child2", 6)) == 1);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+      dto->child1->list->pushBack(nullptr);
+
+      oatpp::dtoql::ValueIndexSet indexes;
+      OATPP_ASSERT(indexes.build(oatpp::dtoql::PathParser::parse("*['list', 'map']"), dto, {"int_value"}, true) == 4);
+      OATPP_ASSERT(indexes.build(oatpp::dtoql::PathParser::parse("['child1']['list']"), dto, {"str_value"}) == 1);
+
+      const char* paths[] = {
+        "['child1']['list'][?(@.int_value == 7)]['str_value']",
+        "*['list', 'map'][?(@.int_value == 1003.0 && @.bool_value == false)]",
+        "*['map'][?(@.int_value >= 1008 || @.int_value < 2)]",
+        "*['list'][?(@.int_value < 3)]",
+        "*['map'][?(@.int_value > 1007)]",
+        "['child1']['list'][?(@.str_value == 'Str.5')]",
+        "['child1']['list'][?(@.str_value >= 'Str.8')]",
+        "['child1']['list'][?(@.int_value == 'x')]"
+      };
+      v_int64 expectedCounts[] = {1, 2, 4, 3, 2, 1, 2, 0};
+
+      /* indexed and scanned queries give the same rows */
+
+      oatpp::dtoql::Executor indexed;
+      indexed.setValueIndexes(&indexes);
+      oatpp::dtoql::Executor scanned;
+
+      for(v_int32 i = 0; i < 8; i ++) {
+        auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(paths[i]));
+        indexed.start(plan, dto);
+        scanned.start(plan, dto);
+        v_int64 count = 0;
+        while(scanned.next()) {
+          OATPP_ASSERT(indexed.next());
+          auto a = indexed.getRow();
+          auto b = scanned.getRow();
+          OATPP_ASSERT(a.getSize() == b.getSize());
+          for(v_int32 level = 1; level < a.getSize(); level ++) {
+            OATPP_ASSERT(a[level].index == b[level].index && a[level].value == b[level].value);
+          }
+          count ++;
+        }
+        OATPP_ASSERT(!indexed.next());
+        OATPP_ASSERT(count == expectedCounts[i]);
+      }
+
+      oatpp::dtoql::QueryStats stats;
+      indexed.setStats(&stats);
+      indexed.start(oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child2']['list'][?(@.int_value == 1004)]")), dto);
+      while(indexed.next()) {}
+      OATPP_ASSERT(stats.getComponentStats(2).selected == 1);
+      OATPP_ASSERT(stats.getComponentStats(2).rejected == 0);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+
+      auto compile = [](const char* text) {
+        return oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(text));
+      };
+
+      auto plan = compile("$child['list', 'map']$item['str_value']");
+      OATPP_ASSERT(plan->getVariableLevel("child") == 1 && plan->getVariableLevel("item") == 3 && plan->getVariableLevel("x") == -1);
+
+      oatpp::dtoql::Executor::execute(plan, dto, [](const oatpp::dtoql::Executor::Row& row) {
+        OATPP_ASSERT(row.getBinding("item") == &row[3]);
+        OATPP_ASSERT(row.getBinding("x") == nullptr);
+        return oatpp::dtoql::Executor::RowVisitor::STOP;
+      });
+
+      oatpp::dtoql::Traverser traverser(plan, dto);
+      OATPP_ASSERT(traverser.getBindingColumn("child") == 1);
+      OATPP_ASSERT(traverser.getBindingColumn(nullptr) == -1);
+
+      bool failed = false;
+      try {
+        compile("$a*$a");
+      } catch(const std::runtime_error& e) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed);
+
+      /* list elements of child1 joined with map entries of both children on int_value */
+
+      dto->child2->map->put("Key-Obj-2.x", dto->child1->list->get(4));
+
+      oatpp::dtoql::Join::Source left(compile("['child1']['list']$o"), dto, "o", {"int_value"});
+      oatpp::dtoql::Join::Source right(compile("*['map']$m"), dto, "m", {"int_value"});
+
+      std::vector<std::string> pairs;
+      v_int64 count = oatpp::dtoql::Join::execute(left, right, [&pairs](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+        OATPP_ASSERT(l.getBinding("o")->value->get() == r.getBinding("m")->value->get());
+        pairs.push_back(std::to_string(l[3].index) + "=" + r.getBinding("m")->getName()->std_str());
+        return true;
+      });
+
+      OATPP_ASSERT(count == 11);
+      OATPP_ASSERT(pairs[0] == "0=Key.0");
+      OATPP_ASSERT(std::count(pairs.begin(), pairs.end(), "4=Key-Obj-2.x") == 1);
+
+      /* build side is the right one - the left one is streamed */
+      std::vector<std::string> swapped;
+      OATPP_ASSERT(oatpp::dtoql::Join::execute(right, left, [&swapped](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+        OATPP_ASSERT(l.getBinding("m")->value->get() == r.getBinding("o")->value->get());
+        swapped.push_back(std::to_string(r[3].index) + "=" + l.getBinding("m")->getName()->std_str());
+        return true;
+      }) == 11);
+      std::sort(pairs.begin(), pairs.end());
+      std::sort(swapped.begin(), swapped.end());
+      OATPP_ASSERT(swapped == pairs);
+
+      OATPP_ASSERT(oatpp::dtoql::Join::execute(right, left, [](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+        return false;
+      }) == 1);
+
+      /* no variable name - the path has no such variable */
+      oatpp::dtoql::Join::Source unnamed(compile("['child2']['list']$k"), dto, nullptr, {"int_value"});
+      failed = false;
+      try {
+        oatpp::dtoql::Join::execute(left, unnamed, [](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+          return true;
+        });
+      } catch(const std::runtime_error& e) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed);
+
+      oatpp::dtoql::Join::Source keys(compile("['child2']['list']$k['int_value']"), dto, "k", {});
+      OATPP_ASSERT(oatpp::dtoql::Join::execute(left, keys, [](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+        return true;
+      }) == 0);
+
+      /* descent of depth 0 selects the root again - it must outlive the executor of the side */
+      oatpp::dtoql::Join::Source descent(compile("..{0}['child1']['list']$d"), dto, "d", {"int_value"});
+      OATPP_ASSERT(oatpp::dtoql::Join::execute(descent, right, [&dto](const oatpp::dtoql::Join::Row& l, const oatpp::dtoql::Join::Row& r) {
+        OATPP_ASSERT(l[0].value->get() == dto.get());
+        OATPP_ASSERT(l[1].value->get() == dto.get());
+        OATPP_ASSERT(l.getBinding("d")->value->get() == r.getBinding("m")->value->get());
+        return true;
+      }) == 11);
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+
+      auto compile = [](const char* text) {
+        return oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse(text));
+      };
+
+      /* list and map of each child share their objects - each field is written twice */
+      OATPP_ASSERT(oatpp::dtoql::Mutator::set(compile("*['list', 'map']*['str_value']"), dto, oatpp::String("***")) == 40);
+      OATPP_ASSERT(dto->child1->map->get("Key.3", nullptr)->str_value == "***");
+
+      OATPP_ASSERT(oatpp::dtoql::Mutator::apply(compile("['child2']['list']*['int_value']"), dto, [](const oatpp::dtoql::Executor::Row& row) {
+        auto value = oatpp::data::mapping::type::static_wrapper_cast<oatpp::Int32::ObjectType>(*row[row.getSize() - 1].value);
+        return oatpp::Int32(value->getValue() + 1);
+      }) == 10);
+      OATPP_ASSERT(dto->child2->list->get(9)->int_value->getValue() == 1010);
+
+      OATPP_ASSERT(oatpp::dtoql::Mutator::remove(compile("['child1']['list'][?(@.int_value >= 5 || @.int_value == 0)]"), dto) == 6);
+      OATPP_ASSERT(dto->child1->list->count() == 4);
+      OATPP_ASSERT(dto->child1->list->get(0)->int_value->getValue() == 1);
+      OATPP_ASSERT(dto->child1->list->get(3)->int_value->getValue() == 4);
+
+      OATPP_ASSERT(oatpp::dtoql::Mutator::remove(compile("['child1']['map']['Key.1', 'Key.9', 'Key.1', 0]"), dto) == 3);
+      OATPP_ASSERT(dto->child1->map->count() == 7);
+      OATPP_ASSERT(dto->child1->map->getFirstEntry()->getKey() == "Key.2");
+
+      /* map emptied without re-putting entries */
+      auto emptied = dto->child2->map;
+      OATPP_ASSERT(oatpp::dtoql::Mutator::remove(compile("['child2']['map']*"), dto) == 10);
+      OATPP_ASSERT(emptied->count() == 0 && emptied->getFirstEntry() == nullptr);
+
+      OATPP_ASSERT(oatpp::dtoql::Mutator::remove(compile("['child2']['map']"), dto) == 1);
+      OATPP_ASSERT(!dto->child2->map);
+
+      bool failed = false;
+      try {
+        oatpp::dtoql::Mutator::remove(compile("['child1']..{1}"), dto);
+      } catch(const std::runtime_error& e) {
+        failed = true;
+      }
+      OATPP_ASSERT(failed);
+
+    }
+
+    {
+
+      /* rows fetched before run() are not seen by the visitor - the first visited row starts from the root */
+
+      auto dto = createTestDto();
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list']*['int_value']"));
+
+      oatpp::dtoql::Executor executor(plan, dto);
+      OATPP_ASSERT(executor.skip(4) == 4);
+      OATPP_ASSERT(executor.next());
+
+      oatpp::dtoql::ResultTree tree;
+      OATPP_ASSERT(executor.run(tree) == 15);
+
+      std::vector<oatpp::dtoql::Traverser::Field> row;
+      tree.getRow(0, row);
+      OATPP_ASSERT(row.size() == 5);
+      OATPP_ASSERT(row[1].getName() == "child1" && row[3].getIndex() == 5);
+      tree.getRow(5, row);
+      OATPP_ASSERT(row[1].getName() == "child2" && row[3].getIndex() == 0);
+
+      oatpp::data::stream::BufferOutputStream stream;
+      oatpp::dtoql::JsonResultWriter writer(&stream, oatpp::dtoql::JsonResultWriter::NESTED);
+      executor.start(oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("['child1']['list']*['int_value']")), dto);
+      executor.skip(8);
+      executor.run(writer);
+      writer.finish();
+      OATPP_ASSERT(stream.toString() == "{\"child1\":{\"list\":[{\"int_value\":8},{\"int_value\":9}]}}");
+
+    }
+
+    {
+
+      auto dto = createTestDto();
+      auto plan = oatpp::dtoql::CompiledPath::compile(oatpp::dtoql::PathParser::parse("*['list', 'map']*['int_value']"));
+
+      struct Sink : public oatpp::dtoql::AsyncRowSink {
+
+        std::vector<std::string> rows;
+        size_t stopAfter = 0;
+        v_int32 slices = 0;
+        v_int32 finishedCalls = 0;
+        v_int64 finishedCount = -1;
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        static std::string describe(const oatpp::dtoql::Executor::Row& row) {
+          std::string result = std::to_string(row.getChangedLevel());
+          for(v_int32 i = 1; i < row.getSize(); i ++) {
+            auto name = row[i].getName();
+            result += "/" + (name ? name->std_str() : std::to_string(row[i].index));
+          }
+          return result;
+        }
+
+        Action onRow(const oatpp::dtoql::Executor::Row& row) override {
+          rows.push_back(describe(row));
+          return rows.size() == stopAfter ? STOP : CONTINUE;
+        }
+
+        void onSliceEnd() override {
+          slices ++;
+        }
+
+        void onFinished(v_int64 rowsCount) override {
+          std::lock_guard<std::mutex> lock(mutex);
+          finishedCalls ++;
+          finishedCount = rowsCount;
+          condition.notify_all();
+        }
+
+        void wait() {
+          std::unique_lock<std::mutex> lock(mutex);
+          condition.wait(lock, [this] { return finishedCalls > 0; });
+        }
+
+      };
+
+      std::vector<std::string> expected;
+      oatpp::dtoql::Executor::execute(plan, dto, [&expected](const oatpp::dtoql::Executor::Row& row) {
+        expected.push_back(Sink::describe(row));
+        return oatpp::dtoql::Executor::RowVisitor::CONTINUE;
+      });
+      OATPP_ASSERT(expected.size() == 40);
+
+      auto all = std::make_shared<Sink>();
+      auto stopped = std::make_shared<Sink>();
+      stopped->stopAfter = 5;
+
+      /* both queries share one worker - slices of them interleave */
+      oatpp::async::Executor executor(1);
+      executor.execute<oatpp::dtoql::QueryCoroutine>(plan, dto, all, (v_int64) 4);
+      executor.execute<oatpp::dtoql::QueryCoroutine>(plan, dto, stopped, (v_int64) 4);
+      all->wait();
+      stopped->wait();
+      executor.stop();
+      executor.join();
+
+      OATPP_ASSERT(all->rows == expected);
+      OATPP_ASSERT(all->finishedCalls == 1);
+      OATPP_ASSERT(all->finishedCount == 40);
+      OATPP_ASSERT(all->slices >= 10);
+
+      OATPP_ASSERT(stopped->rows.size() == 5);
+      OATPP_ASSERT(std::equal(stopped->rows.begin(), stopped->rows.end(), expected.begin()));
+      OATPP_ASSERT(stopped->finishedCalls == 1);
+      OATPP_ASSERT(stopped->finishedCount == 5);
+
+    }
+
+    {
+
+      oatpp::dtoql::VisitedSet visited(4);
+      std::vector<v_int64> keys(1000);
+
+      for(v_int32 pass = 0; pass < 3; pass ++) {
+        visited.clear();
+        for(v_int32 i = 0; i < 1000; i ++) {
+          OATPP_ASSERT(visited.insert(&keys[i]));
+        }
+        OATPP_ASSERT(!visited.insert(&keys[0]) && !visited.insert(&keys[999]));
+        OATPP_ASSERT(visited.getSize() == 1000);
+      }
+
+      /* slots are reused - a set which has grown once does not grow again */
+      OATPP_ASSERT(visited.getCapacity() == 2048);
+
+      visited.clear();
+      OATPP_ASSERT(visited.getSize() == 0);
+      OATPP_ASSERT(visited.insert((v_uint64) 0));
+      OATPP_ASSERT(!visited.insert((v_uint64) 0));
+
     }
 
     {
@@ -150,6 +1247,8 @@ public:
         traverser.printResultTable();
       }
 
+      OATPP_ASSERT(traverser.getResultTable().size() == 9);
+
     }
 
   }